@@ -10,20 +10,77 @@
 /// Enables/disables `operator<<()` overloading for hyper_array::array
 #define HYPER_ARRAY_CONFIG_Overload_Stream_Operator 1
 #endif
+/// the values of HYPER_ARRAY_CONFIG_Bounds_Check
+#define HYPER_ARRAY_BOUNDS_CHECK_OFF    0  ///< no checks
+#define HYPER_ARRAY_BOUNDS_CHECK_ASSERT 1  ///< print a message and assert() (i.e. no checks if NDEBUG is defined)
+#define HYPER_ARRAY_BOUNDS_CHECK_THROW  2  ///< throw std::out_of_range
+#define HYPER_ARRAY_BOUNDS_CHECK_TRAP   3  ///< print a message and abort, even if NDEBUG is defined
+#ifndef HYPER_ARRAY_CONFIG_Bounds_Check
+/// Selects what the checked accessors (at(), rawIndex()), slice(), permute() and swap_axes() do with out-of-range indices
+/// The check itself is a single branch; the message is only formatted when an index is out of range.
+#define HYPER_ARRAY_CONFIG_Bounds_Check HYPER_ARRAY_BOUNDS_CHECK_ASSERT
+#endif
+#ifndef HYPER_ARRAY_CONFIG_Memory_Mapping
+/// Enables/disables hyper_array::mapped_array (memory-mapped files)
+/// It requires a POSIX system (mmap). It is always disabled on other systems.
+#define HYPER_ARRAY_CONFIG_Memory_Mapping 1
+#endif
+#ifndef HYPER_ARRAY_CONFIG_SIMD
+/// Enables/disables the SSE2/AVX2/AVX-512 implementations of the hyper_array::simd kernels
+/// They require x86 and gcc or clang. The kernels fall back to scalar code when they are disabled.
+#define HYPER_ARRAY_CONFIG_SIMD 1
+#endif
 // </editor-fold>
 
 // <editor-fold desc="Includes">
 // std
 //#include <algorithm>       // during dev. replaced by compile-time equivalents in hyper_array::internal
 #include <array>             // std::array for hyper_array::array::dimensionLengths and indexCoeffs
+#include <atomic>            // std::atomic in hyper_array::simd::set_instruction_set()
 #include <cassert>           // assert()
+#include <clocale>           // std::localeconv() in hyper_array::read_text()
+#include <cerrno>            // errno in hyper_array::save(), load() and mapped_array
+#include <cmath>             // std::sqrt etc. in the expression templates
+#include <condition_variable>  // std::condition_variable in hyper_array::thread_pool
+#include <cstdint>           // std::uintptr_t in hyper_array::aligned_allocator, std::uint64_t in hyper_array::simd
+#include <cstdio>            // std::fputs in hyper_array::internal::indexOutOfRange(), std::FILE in hyper_array::save()
+#include <cstdlib>           // std::abort in hyper_array::internal::indexOutOfRange(), std::strtod in hyper_array::read_text()
+#include <cstring>           // std::memcpy in hyper_array::aligned_allocator and hyper_array::simd
+#include <exception>         // std::exception_ptr in hyper_array::hyperslab_reader and hyperslab_writer
+#include <functional>        // std::function in hyper_array::thread_pool
 #include <initializer_list>  // std::initializer_list for the constructors
-#include <memory>            // std::unique_ptr for hyper_array::array::_dataOwner
-#include <sstream>           // stringstream in hyper_array::array::validateIndexRanges()
+#include <istream>           // std::istream in hyper_array::read_text()
+#include <iterator>          // std::move_iterator in the move assignments of hyper_array::array and extents_array
+#include <limits>            // std::numeric_limits in hyper_array::min() and max()
+#include <memory>            // std::unique_ptr for hyper_array::array::_dataOwner, std::allocator_traits
+#include <mutex>             // std::mutex in hyper_array::thread_pool
+#include <new>               // ::operator new in hyper_array::aligned_allocator
+#include <ostream>           // std::ostream in hyper_array::write_text() and the overloaded operator<<()
+#include <sstream>           // stringstream in hyper_array::internal::indexOutOfRange()
+#include <stdexcept>         // std::out_of_range in hyper_array::internal::indexOutOfRange(), std::length_error, std::invalid_argument
+#include <string>            // std::string in hyper_array::internal::indexOutOfRange()
+#include <system_error>      // std::system_error in hyper_array::save(), load() and mapped_array
+#include <thread>            // std::thread in hyper_array::thread_pool
 #include <type_traits>       // template metaprogramming stuff in hyper_array::internal
+#include <utility>           // std::declval in hyper_array::array::slice()
+#include <vector>            // std::vector in hyper_array::thread_pool and the parallel algorithms
+#if HYPER_ARRAY_CONFIG_SIMD && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define HYPER_ARRAY_SIMD_X86 1
+#include <immintrin.h>       // SSE2/AVX2/AVX-512 intrinsics in hyper_array::simd
+#else
+#define HYPER_ARRAY_SIMD_X86 0
+#endif
+#if HYPER_ARRAY_CONFIG_Memory_Mapping && (defined(__unix__) || defined(__APPLE__))
+#define HYPER_ARRAY_MEMORY_MAPPING 1
+#include <fcntl.h>           // open() in hyper_array::mapped_array
+#include <sys/mman.h>        // mmap() in hyper_array::mapped_array
+#include <sys/stat.h>        // fstat() in hyper_array::mapped_array
+#include <unistd.h>          // close(), ftruncate() in hyper_array::mapped_array
+#else
+#define HYPER_ARRAY_MEMORY_MAPPING 0
+#endif
 #if HYPER_ARRAY_CONFIG_Overload_Stream_Operator
 #include <iterator>          // std::ostream_iterator in operator<<()
-#include <ostream>           // std::ostream for the overloaded operator<<()
 #endif
 // </editor-fold>
 
@@ -40,7 +97,31 @@ enum class array_order : int
     COLUMN_MAJOR = 1   ///< a.k.a. Fortran-style order
 };
 
+/// tag type for creating hyper arrays whose elements are left uninitialized
+/// @see hyper_array::uninitialized
+struct uninitialized_t
+{};
+
+/// tag for creating hyper arrays whose elements are left uninitialized
+/// i.e. the data array is allocated but never touched (for trivial element types)
+/// @code
+///     hyper_array::array<double, 3> grid{hyper_array::uninitialized, 1024, 1024, 1024};
+/// @endcode
+constexpr uninitialized_t uninitialized{};
+
 // <editor-fold defaultstate="collapsed" desc="Internal Helper Blocks">
+/// branch prediction hint and out-of-line attribute for the error paths
+#if defined(__GNUC__)
+#define HYPER_ARRAY_UNLIKELY(condition) __builtin_expect(!!(condition), 0)
+#define HYPER_ARRAY_NOINLINE            __attribute__((noinline, cold))
+#elif defined(_MSC_VER)
+#define HYPER_ARRAY_UNLIKELY(condition) (condition)
+#define HYPER_ARRAY_NOINLINE            __declspec(noinline)
+#else
+#define HYPER_ARRAY_UNLIKELY(condition) (condition)
+#define HYPER_ARRAY_NOINLINE
+#endif
+
 /// helper functions for hyper_array::array's implementation
 /// @note Everything here is subject to change and must NOT be used by user code
 namespace internal
@@ -138,6 +219,198 @@ T ct_inner_product(const ::std::array<T_1, N_1>& arr_1,  ///< calc the inner pro
          : initialValue;
 }
 
+/// alignment of the memory returned by `Allocator`
+/// `Allocator::alignment` if it is defined, `alignof(Allocator::value_type)` otherwise
+template <typename Allocator, typename = void>
+struct allocator_alignment
+: std::integral_constant<std::size_t, alignof(typename std::allocator_traits<Allocator>::value_type)>
+{};
+
+template <typename Allocator>
+struct allocator_alignment<Allocator, enable_if_t<(Allocator::alignment > 0), void>>
+: std::integral_constant<std::size_t, Allocator::alignment>
+{};
+
+/// tells the compiler that `ptr` is aligned on an `Alignment`-byte boundary
+/// @note behaves like C++20's `std::assume_aligned()`
+template <std::size_t Alignment, typename T>
+inline T* assume_aligned(T* ptr) noexcept
+{
+    #if defined(__GNUC__) || defined(__clang__)
+    return static_cast<T*>(__builtin_assume_aligned(ptr, Alignment));
+    #else
+    return ptr;
+    #endif
+}
+
+/// checks whether `ptr` is aligned on an `alignment`-byte boundary
+inline bool is_aligned(const void* ptr, const std::size_t alignment) noexcept
+{
+    return (reinterpret_cast<std::uintptr_t>(ptr) % alignment) == 0;
+}
+
+/// deleter of hyper_array::array's data array
+/// destroys the elements then gives the memory back to `Allocator`
+///
+/// @note `Allocator` is inherited in order to take advantage of
+///       the empty base optimization (most allocators are stateless)
+template <typename Allocator>
+class allocator_deleter : private Allocator
+{
+    using traits = std::allocator_traits<Allocator>;
+
+public:
+
+    using allocator_type = Allocator;
+    using value_type     = typename traits::value_type;
+    using size_type      = typename traits::size_type;
+
+    static_assert(std::is_same<typename traits::pointer, value_type*>::value,
+                  "hyper_array::array doesn't support allocators with fancy pointers");
+
+    allocator_deleter() = default;
+
+    allocator_deleter(const allocator_type& allocator, const size_type count) noexcept
+    : Allocator(allocator)
+    , _count   (count)
+    {}
+
+    /// the allocator that is used for releasing the memory
+    const allocator_type& allocator() const noexcept
+    {
+        return *this;
+    }
+
+    /// allocates and value-initializes `count` elements
+    static value_type* allocate(const allocator_type& allocator, const size_type count)
+    {
+        allocator_type alloc(allocator);
+        value_type* const data = traits::allocate(alloc, count);
+        size_type i = 0;
+        try
+        {
+            for (; i < count; ++i)
+            {
+                traits::construct(alloc, data + i);
+            }
+        }
+        catch (...)
+        {
+            destroy(alloc, data, i);
+            traits::deallocate(alloc, data, count);
+            throw;
+        }
+        return data;
+    }
+
+    /// allocates `count` elements without initializing them
+    /// @note non-trivial types still need to be constructed
+    static value_type* allocate(const allocator_type& allocator, const size_type count, uninitialized_t)
+    {
+        if (std::is_trivial<value_type>::value)
+        {
+            allocator_type alloc(allocator);
+            return traits::allocate(alloc, count);
+        }
+        return allocate(allocator, count);
+    }
+
+    /// allocates `count` elements and copy-constructs them from `source`
+    /// (or move-constructs them, if `source` is a `std::move_iterator`)
+    template <typename InputIterator>
+    static value_type* clone(const allocator_type& allocator, InputIterator source, const size_type count)
+    {
+        allocator_type alloc(allocator);
+        value_type* const data = traits::allocate(alloc, count);
+        size_type i = 0;
+        try
+        {
+            for (; i < count; ++i, ++source)
+            {
+                traits::construct(alloc, data + i, *source);
+            }
+        }
+        catch (...)
+        {
+            destroy(alloc, data, i);
+            traits::deallocate(alloc, data, count);
+            throw;
+        }
+        return data;
+    }
+
+    void operator()(value_type* data) const noexcept
+    {
+        allocator_type alloc(allocator());
+        destroy(alloc, data, _count);
+        traits::deallocate(alloc, data, _count);
+    }
+
+private:
+
+    static void destroy(allocator_type& alloc, value_type* data, size_type count) noexcept
+    {
+        while (count > 0)
+        {
+            traits::destroy(alloc, data + --count);
+        }
+    }
+
+    /// number of elements to destroy/deallocate
+    size_type _count = 0;
+};
+
+/// `std::allocator` keeps the `new[]`/`delete[]` contract
+/// (i.e. raw data passed to hyper_array::array can be allocated with `new[]`)
+/// and adds no overhead to hyper_array::array
+template <typename ValueType>
+class allocator_deleter<std::allocator<ValueType>>
+{
+public:
+
+    using allocator_type = std::allocator<ValueType>;
+    using value_type     = ValueType;
+    using size_type      = std::size_t;
+
+    allocator_deleter() = default;
+
+    allocator_deleter(const allocator_type&, const size_type) noexcept
+    {}
+
+    allocator_type allocator() const noexcept
+    {
+        return {};
+    }
+
+    static value_type* allocate(const allocator_type&, const size_type count)
+    {
+        #if (__cplusplus < 201402L)  // C++14 ?
+        return new value_type[count];
+        #else
+        // same as std::make_unique<value_type[]>(), which is not part of C++11
+        return new value_type[count]();
+        #endif
+    }
+
+    static value_type* allocate(const allocator_type&, const size_type count, uninitialized_t)
+    {
+        // default-initialization: trivial types are left untouched
+        return new value_type[count];
+    }
+
+    static value_type* clone(const allocator_type& allocator, const value_type* source, const size_type count)
+    {
+        std::unique_ptr<value_type[]> data{allocate(allocator, count)};
+        std::copy(source, source + count, data.get());
+        return data.release();
+    }
+
+    void operator()(value_type* data) const noexcept
+    {
+        delete[] data;
+    }
+};
+
 /// computes the index coefficients given a specific "Order"
 /// row-major order
 template <typename size_type, std::size_t Dimensions, array_order Order>
@@ -206,425 +479,7881 @@ computeIndexCoeffs(const ::std::array<size_type, Dimensions>& dimensionLengths)
     return coeffs;
 }
 
-}
-// </editor-fold>
-
-/// A multi-dimensional array
-/// Inspired by [orca_array](https://github.com/astrobiology/orca_array)
-template <
-    typename    ValueType,                      ///< elements' type
-    std::size_t Dimensions,                     ///< number of dimensions
-    array_order Order = array_order::ROW_MAJOR  /// storage order
->
-class array
-{
-    // Types ///////////////////////////////////////////////////////////////////////////////////////
-
-public:
-
-    // <editor-fold defaultstate="collapsed" desc="STL-like types">
-    // from <array>
-    using value_type             = ValueType;
-    using pointer                = value_type*;
-    using const_pointer          = const value_type*;
-    using reference              = value_type&;
-    using const_reference        = const value_type&;
-    using iterator               = value_type*;
-    using const_iterator         = const value_type*;
-    using size_type              = std::size_t;
-    using difference_type        = std::ptrdiff_t;
-    using reverse_iterator       = std::reverse_iterator<iterator>;
-    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-    // others
-    using array_type             = array<value_type, Dimensions, Order>;
-    using index_type             = std::size_t;
-    // </editor-fold>
+/// C++11 equivalent of C++14's `std::index_sequence`
+template <std::size_t... Is>
+struct index_sequence
+{};
 
-    // Attributes //////////////////////////////////////////////////////////////////////////////////
+/// C++11 equivalent of C++14's `std::make_index_sequence`
+template <std::size_t N, std::size_t... Is>
+struct make_index_sequence_impl : make_index_sequence_impl<N - 1, N - 1, Is...>
+{};
 
-    // <editor-fold desc="Class Attributes">
-private:
-    // ::std::array's are used here mainly (only?) because they are initializable
-    // from `std::initializer_list` and they support move semantics
-    // cf. hyper_array::array's constructors
-    // also ::std::array seem to introduce no overhead over the data they hold
-    // i.e. sizeof(::std::array<Type, Length>) == sizeof(Type) * Length
+template <std::size_t... Is>
+struct make_index_sequence_impl<0, Is...>
+{
+    using type = index_sequence<Is...>;
+};
 
-    /// number of elements in each dimension
-    ::std::array<size_type, Dimensions> _lengths;
+template <std::size_t N>
+using make_index_sequence = typename make_index_sequence_impl<N>::type;
 
-    /// coefficients to use when computing the index
-    /// @see at()
-    ::std::array<size_type, Dimensions> _coeffs;
+/// compile-time sum of a parameter pack
+template <typename T>
+constexpr T ct_sum(const T x) { return x; }
 
-    /// total number of elements in the data array
-    size_type _size;
+template <typename T, typename... Ts>
+constexpr T ct_sum(const T x, const Ts... xs) { return x + ct_sum(xs...); }
 
-    /// handles the lifecycle of the dynamically allocated data array
-    /// The user doesn't need to access it directly
-    /// If the user needs access to the allocated array, they can use data()
-    std::unique_ptr<value_type[]> _dataOwner;
-    // </editor-fold>
+/// compile-time product of the elements of a parameter pack
+/// whose positions are in the `[first, last)` range
+/// @note `position` is the position of `x` in the pack
+constexpr std::size_t ct_prod_range(const std::size_t /*first*/, const std::size_t /*last*/, const std::size_t /*position*/)
+{
+    return 1;
+}
 
-    // methods /////////////////////////////////////////////////////////////////////////////////////
+template <typename... Ts>
+constexpr std::size_t ct_prod_range(const std::size_t first, const std::size_t last, const std::size_t position,
+                                    const std::size_t x, const Ts... xs)
+{
+    return ((first <= position) && (position < last) ? x : 1)
+         * ct_prod_range(first, last, position + 1, xs...);
+}
 
-public:
+/// compile-time equivalent of `computeIndexCoeffs()` for a single dimension
+/// given the lengths of all the dimensions
+template <array_order Order, typename... Ts>
+constexpr std::size_t ct_index_coeff(const std::size_t dimension, const Ts... lengths)
+{
+    return (Order == array_order::ROW_MAJOR)
+         ? ct_prod_range(dimension + 1, sizeof...(Ts), 0, lengths...)  // row-major:    prod(L[i+1 : N])
+         : ct_prod_range(0, dimension,                 0, lengths...); // column-major: prod(L[0 : i])
+}
 
-    // <editor-fold defaultstate="collapsed" desc="Constructors">
-    /// would it make sense to create an array without specifying the dimension lengths ?
-    array() = delete;
+/// compile-time count of the elements of a parameter pack that are equal to `value`
+/// and whose positions are in the `[first, last)` range
+/// @note `position` is the position of `x` in the pack
+constexpr std::size_t ct_count_range(const std::size_t /*value*/, const std::size_t /*first*/, const std::size_t /*last*/,
+                                     const std::size_t /*position*/)
+{
+    return 0;
+}
 
-    /// copy-constructor
-    array(const array_type& other)
-    : _lengths   (other._lengths)
-    , _coeffs    (other._coeffs)
-    , _size      (other._size)
-    , _dataOwner {other.cloneData()}
-    {}
+template <typename... Ts>
+constexpr std::size_t ct_count_range(const std::size_t value, const std::size_t first, const std::size_t last,
+                                     const std::size_t position, const std::size_t x, const Ts... xs)
+{
+    return ((first <= position) && (position < last) && (x == value) ? 1 : 0)
+         + ct_count_range(value, first, last, position + 1, xs...);
+}
 
-    /// move constructor
-    array(array_type&& other)
-    : _lengths   (std::move(other._lengths))
-    , _coeffs    (std::move(other._coeffs))
-    , _size      (other._size)
-    , _dataOwner {std::move(other._dataOwner)}
-    {}
+/// checks whether the index coefficient of a dimension only depends on lengths
+/// that are known at compile-time (i.e. are not equal to `unknownLength`)
+template <array_order Order, typename... Ts>
+constexpr bool ct_is_static_coeff(const std::size_t dimension, const std::size_t unknownLength, const Ts... lengths)
+{
+    return (Order == array_order::ROW_MAJOR)
+         ? ct_count_range(unknownLength, dimension + 1, sizeof...(Ts), 0, lengths...) == 0
+         : ct_count_range(unknownLength, 0, dimension,                 0, lengths...) == 0;
+}
 
-    /// the usual way of constructing hyper arrays
-    template <
-        typename... DimensionLengths,
-        typename = internal::enable_if_t<
-            (sizeof...(DimensionLengths) == Dimensions) && internal::are_integral<DimensionLengths...>::value,
-            void>
-    >
-    array(DimensionLengths... dimensionLengths)
-    : _lengths   {{static_cast<size_type>(dimensionLengths)...}}
-    , _coeffs    (internal::computeIndexCoeffs<size_type, Dimensions, Order>(_lengths))
-    , _size      (computeDataSize(_lengths))
-    , _dataOwner {allocateData(_size)}
-    {}
+/// number of index coefficients, before `dimension`, that are not known at compile-time
+/// i.e. the position of `dimension`'s coefficient among the run-time ones
+template <array_order Order, typename... Ts>
+constexpr std::size_t ct_dynamic_coeff_index(const std::size_t dimension, const std::size_t unknownLength, const Ts... lengths)
+{
+    return (dimension == 0)
+         ? 0
+         : ct_dynamic_coeff_index<Order>(dimension - 1, unknownLength, lengths...)
+           + (ct_is_static_coeff<Order>(dimension - 1, unknownLength, lengths...) ? 0 : 1);
+}
 
-    /// Creates a new hyper array from "raw data"
-    ///
-    /// @note `*this` will maintain ownership of `rawData`
-    ///       unless e.g. data are `std::move`d from it
-    array(::std::array<size_type, Dimensions> lengths,  ///< length of each dimension
-          value_type* rawData = nullptr  ///< raw data
-                                         ///< must contain `computeIndexCoeffs(lengths)`
-                                         ///< if `nullptr`, a new data array will be allocated
-    )
-    : _lengths   (std::move(lengths))
-    , _coeffs    (internal::computeIndexCoeffs<size_type, Dimensions, Order>(lengths))
-    , _size      (computeDataSize(_lengths))
-    , _dataOwner {rawData == nullptr ? allocateData(_size).release() : rawData}
-    {}
+/// holds the index coefficients that are only known at run-time
+/// @note meant to be used as a base class, in order to take advantage of
+///       the empty base optimization when all the coefficients are known at compile-time
+template <std::size_t Count>
+struct dynamic_coeffs_storage
+{
+    ::std::array<std::size_t, Count> _dynamicCoeffs;
 
-    /// Creates a new hyper array from an initializer list
-    array(::std::array<size_type, Dimensions> lengths,  ///< length of each dimension
-          std::initializer_list<value_type>   values,   ///< {the initializer list}
-          const value_type& defaultValue      = {}      ///< default value, in case `values.size() < size()`
-    )
-    : _lengths   (std::move(lengths))
-    , _coeffs    (internal::computeIndexCoeffs<size_type, Dimensions, Order>(lengths))
-    , _size      (computeDataSize(_lengths))
-    , _dataOwner {allocateData(_size).release()}
+    /// keeps the coefficients that are not static
+    template <std::size_t N>
+    void setDynamicCoeffs(const ::std::array<std::size_t, N>& coeffs, const ::std::array<bool, N>& isStatic) noexcept
     {
-        if (values.size() <= size())
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < N; ++i)
         {
-            std::copy(values.begin(),
-                      values.end(),
-                      _dataOwner.get());
-
-            // fill any remaining number of uninitialized elements with the default value
-            if (values.size() < size())
+            if (!isStatic[i])
             {
-                std::fill(_dataOwner.get() + values.size(),
-                          _dataOwner.get() + size(),
-                          defaultValue);
+                _dynamicCoeffs[k++] = coeffs[i];
             }
         }
-        else
+    }
+};
+
+template <>
+struct dynamic_coeffs_storage<0>
+{
+    template <std::size_t N>
+    void setDynamicCoeffs(const ::std::array<std::size_t, N>&, const ::std::array<bool, N>&) noexcept
+    {}
+};
+
+/// reports the out-of-range indices, according to HYPER_ARRAY_CONFIG_Bounds_Check
+/// @note this is the slow path of validateIndexRanges(), kept out of line
+template <typename size_type, typename index_type, std::size_t Dimensions>
+HYPER_ARRAY_NOINLINE
+void indexOutOfRange(const ::std::array<size_type,  Dimensions>& lengths,
+                     const ::std::array<index_type, Dimensions>& indexArray)
+{
+    // prepare an exhaustive report
+    std::ostringstream oss;
+    for (std::size_t i = 0; i < Dimensions; ++i)
+    {
+        if (!(indexArray[i] < lengths[i]))
         {
-            assert(false);
+            oss << "Index #" << i << " [== " << static_cast<std::ptrdiff_t>(indexArray[i]) << "]"
+                << " is out of the [0, " << (lengths[i]-1) << "] range. ";
         }
     }
-    // </editor-fold>
+    const std::string message = oss.str();
 
-    // <editor-fold defaultstate="collapsed" desc="Assignment Operators">
-    /// copy assignment
-    array_type& operator=(const array_type& other)
-    {
-        _lengths   = other._lengths;
-        _coeffs    = other._coeffs;
-        _size      = other._size;
-        _dataOwner = other.cloneData();
+#if HYPER_ARRAY_CONFIG_Bounds_Check == HYPER_ARRAY_BOUNDS_CHECK_THROW
+    throw std::out_of_range(message);
+#else
+    std::fputs(("hyper_array: " + message + "\n").c_str(), stderr);
+#if HYPER_ARRAY_CONFIG_Bounds_Check == HYPER_ARRAY_BOUNDS_CHECK_ASSERT
+    assert(!"index out of range");
+#else
+    std::abort();
+#endif
+#endif
+}
 
-        return *this;
+/// checks that every index is within the `[0, length)` range of its dimension
+/// @see HYPER_ARRAY_CONFIG_Bounds_Check
+template <typename size_type, typename index_type, std::size_t Dimensions>
+::std::array<index_type, Dimensions>
+validateIndexRanges(const ::std::array<size_type,  Dimensions>& lengths,
+                    const ::std::array<index_type, Dimensions>& indexArray)
+{
+#if (HYPER_ARRAY_CONFIG_Bounds_Check == HYPER_ARRAY_BOUNDS_CHECK_THROW) \
+ || (HYPER_ARRAY_CONFIG_Bounds_Check == HYPER_ARRAY_BOUNDS_CHECK_TRAP)  \
+ || ((HYPER_ARRAY_CONFIG_Bounds_Check == HYPER_ARRAY_BOUNDS_CHECK_ASSERT) && !defined(NDEBUG))
+    // the indices are unsigned: negative values are converted into huge ones
+    bool valid = true;
+    for (std::size_t i = 0; i < Dimensions; ++i)
+    {
+        valid = valid & (indexArray[i] < lengths[i]);
     }
-
-    /// move assignment
-    array_type& operator=(array_type&& other)
+    if (HYPER_ARRAY_UNLIKELY(!valid))
     {
-        _lengths   = std::move(other._lengths);
-        _coeffs    = std::move(other._coeffs);
-        _size      = other._size;
-        _dataOwner = std::move(other._dataOwner);
-
+        indexOutOfRange(lengths, indexArray);
+    }
+#else
+    (void)lengths;
+#endif
+    return indexArray;
+}
+
+/// checks the caller's indices, then converts them into `index_type`
+/// i.e. the indices are checked before being narrowed, so that out-of-range ones can't wrap around into the range
+template <typename index_type, typename size_type, std::size_t Dimensions, typename... Indices>
+::std::array<index_type, Dimensions> validateIndices(const ::std::array<size_type, Dimensions>& lengths, const Indices... indices)
+{
+    validateIndexRanges(lengths, ::std::array<std::uint64_t, Dimensions>{{static_cast<std::uint64_t>(indices)...}});
+    return {{static_cast<index_type>(indices)...}};
+}
+
+/// converts index coefficients into (signed) strides
+template <typename size_type, std::size_t Dimensions>
+::std::array<std::ptrdiff_t, Dimensions> toStrides(const ::std::array<size_type, Dimensions>& coeffs) noexcept
+{
+    ::std::array<std::ptrdiff_t, Dimensions> strides;
+    for (std::size_t i = 0; i < Dimensions; ++i)
+    {
+        strides[i] = static_cast<std::ptrdiff_t>(coeffs[i]);
+    }
+    return strides;
+}
+
+/// converts lengths (or indices) into another unsigned type
+/// @throw std::length_error if a value can't be represented by `To`
+template <typename To, typename From, std::size_t Dimensions>
+::std::array<To, Dimensions> convertLengths(const ::std::array<From, Dimensions>& lengths)
+{
+    ::std::array<To, Dimensions> result;
+    for (std::size_t i = 0; i < Dimensions; ++i)
+    {
+        result[i] = static_cast<To>(lengths[i]);
+        if (static_cast<From>(result[i]) != lengths[i])
+        {
+            throw std::length_error("hyper_array: a length overflows size_type");
+        }
+    }
+    return result;
+}
+
+/// compares lengths of possibly different types
+template <typename Left, typename Right, std::size_t Dimensions>
+bool equalLengths(const ::std::array<Left, Dimensions>& left, const ::std::array<Right, Dimensions>& right) noexcept
+{
+    for (std::size_t i = 0; i < Dimensions; ++i)
+    {
+        if (static_cast<std::size_t>(left[i]) != static_cast<std::size_t>(right[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// computes the offset of the element at `indices`, relative to the element at (0, 0, ..., 0)
+template <std::size_t Dimensions>
+std::ptrdiff_t stridedOffset(const ::std::array<std::ptrdiff_t, Dimensions>& strides,
+                             const ::std::array<std::size_t,    Dimensions>& indices) noexcept
+{
+    std::ptrdiff_t offset = 0;
+    for (std::size_t i = 0; i < Dimensions; ++i)
+    {
+        offset += static_cast<std::ptrdiff_t>(indices[i]) * strides[i];
+    }
+    return offset;
+}
+
+/// returns the dimension that comes at the `rank`-th position
+/// when going from the fastest-varying dimension to the slowest-varying one
+template <array_order Order, std::size_t Dimensions>
+constexpr std::size_t dimensionByRank(const std::size_t rank) noexcept
+{
+    return (Order == array_order::ROW_MAJOR) ? (Dimensions - 1 - rank) : rank;
+}
+
+/// iterates over the elements of a (possibly strided) multi-dimensional view
+/// in the order defined by `Order` (i.e. in memory order when the view is dense)
+///
+/// The current multi-index and data offset are updated incrementally:
+/// moving to the next element costs one stride increment, plus a "carry"
+/// whenever the end of a dimension is reached.
+template <typename ValueType, std::size_t Dimensions, array_order Order>
+class strided_iterator
+{
+public:
+
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type        = typename std::remove_const<ValueType>::type;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = ValueType*;
+    using reference         = ValueType&;
+    using size_type         = std::size_t;
+
+    strided_iterator() = default;
+
+    /// @param position  linear position of the element in iteration order,
+    ///                  `size` designates the past-the-end iterator
+    strided_iterator(pointer                                         data,
+                     const ::std::array<size_type,       Dimensions>& lengths,
+                     const ::std::array<difference_type, Dimensions>& coeffs,
+                     const size_type                                  position,
+                     const size_type                                  size) noexcept
+    : _data    (data)
+    , _lengths (lengths)
+    , _coeffs  (coeffs)
+    , _indices ()
+    , _offset  (0)
+    , _position(position)
+    {
+        if (position == size)
+        {
+            // past-the-end: the slowest-varying index "overflows"
+            constexpr std::size_t slowest = dimensionByRank<Order, Dimensions>(Dimensions - 1);
+            _indices[slowest] = _lengths[slowest];
+            _offset           = static_cast<difference_type>(_lengths[slowest]) * _coeffs[slowest];
+        }
+        else
+        {
+            size_type remaining = position;
+            for (size_type rank = 0; rank < Dimensions; ++rank)
+            {
+                const std::size_t dim = dimensionByRank<Order, Dimensions>(rank);
+                _indices[dim] = remaining % _lengths[dim];
+                remaining    /= _lengths[dim];
+                _offset      += static_cast<difference_type>(_indices[dim]) * _coeffs[dim];
+            }
+        }
+    }
+
+    /// allows converting an `iterator` into a `const_iterator`
+    template <
+        typename OtherValueType,
+        typename = enable_if_t<std::is_same<const OtherValueType, ValueType>::value, void>
+    >
+    strided_iterator(const strided_iterator<OtherValueType, Dimensions, Order>& other) noexcept
+    : _data    (other._data)
+    , _lengths (other._lengths)
+    , _coeffs  (other._coeffs)
+    , _indices (other._indices)
+    , _offset  (other._offset)
+    , _position(other._position)
+    {}
+
+    reference operator*()  const noexcept { return _data[_offset];  }
+    pointer   operator->() const noexcept { return _data + _offset; }
+
+    strided_iterator& operator++() noexcept
+    {
+        ++_position;
+        for (size_type rank = 0; rank < Dimensions; ++rank)
+        {
+            const std::size_t dim = dimensionByRank<Order, Dimensions>(rank);
+            ++_indices[dim];
+            _offset += _coeffs[dim];
+            // no carry, or reached the past-the-end state
+            if ((_indices[dim] < _lengths[dim]) || (rank == Dimensions - 1))
+            {
+                break;
+            }
+            // carry
+            _offset       -= static_cast<difference_type>(_lengths[dim]) * _coeffs[dim];
+            _indices[dim]  = 0;
+        }
         return *this;
     }
-    // </editor-fold>
 
-    // <editor-fold defaultstate="collapsed" desc="Whole-Array Iterators">
-    // from <array>
-          iterator         begin()         noexcept { return iterator(data());                }
-    const_iterator         begin()   const noexcept { return const_iterator(data());          }
-          iterator         end()           noexcept { return iterator(data() + size());       }
-    const_iterator         end()     const noexcept { return const_iterator(data() + size()); }
-          reverse_iterator rbegin()        noexcept { return reverse_iterator(end());         }
-    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end());   }
-          reverse_iterator rend()          noexcept { return reverse_iterator(begin());       }
-    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
-    const_iterator         cbegin()  const noexcept { return const_iterator(data());          }
-    const_iterator         cend()    const noexcept { return const_iterator(data() + size()); }
-    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end());   }
-    const_reverse_iterator crend()   const noexcept { return const_reverse_iterator(begin()); }
-    // </editor-fold>
+    strided_iterator& operator--() noexcept
+    {
+        --_position;
+        for (size_type rank = 0; rank < Dimensions; ++rank)
+        {
+            const std::size_t dim = dimensionByRank<Order, Dimensions>(rank);
+            if (_indices[dim] > 0)
+            {
+                --_indices[dim];
+                _offset -= _coeffs[dim];
+                break;
+            }
+            // borrow
+            _indices[dim]  = _lengths[dim] - 1;
+            _offset       += static_cast<difference_type>(_indices[dim]) * _coeffs[dim];
+        }
+        return *this;
+    }
 
-    // <editor-fold defaultstate="collapsed" desc="Template Arguments">
-    /// number of dimensions
-    static constexpr size_type   dimensions() noexcept { return Dimensions; }
-    /// the convention used for arranging the elements
-    static constexpr array_order order()      noexcept { return Order;      }
-    // </editor-fold>
+    strided_iterator operator++(int) noexcept { strided_iterator it{*this}; ++(*this); return it; }
+    strided_iterator operator--(int) noexcept { strided_iterator it{*this}; --(*this); return it; }
+
+    bool operator==(const strided_iterator& other) const noexcept { return _position == other._position; }
+    bool operator!=(const strided_iterator& other) const noexcept { return _position != other._position; }
+
+private:
+
+    template <typename, std::size_t, array_order>
+    friend class strided_iterator;
+
+    pointer                             _data;      ///< first element of the view
+    ::std::array<size_type,       Dimensions> _lengths;   ///< the view's lengths
+    ::std::array<difference_type, Dimensions> _coeffs;    ///< the view's coefficients (can be negative)
+    ::std::array<size_type,       Dimensions> _indices;   ///< current multi-index
+    difference_type                           _offset;    ///< current offset from _data
+    size_type                                 _position;  ///< current position in iteration order
+};
+
+/// moves `indices` to the next element in `Order`, without changing the index of dimension `fixedDimension`
+/// i.e. iterates over the "rows" that run along `fixedDimension`
+template <array_order Order, std::size_t Dimensions>
+void nextRow(::std::array<std::size_t, Dimensions>&       indices,
+             const ::std::array<std::size_t, Dimensions>& lengths,
+             const std::size_t                            fixedDimension) noexcept
+{
+    for (std::size_t rank = 0; rank < Dimensions; ++rank)
+    {
+        const std::size_t dim = dimensionByRank<Order, Dimensions>(rank);
+        if (dim == fixedDimension)
+        {
+            continue;
+        }
+        if (++indices[dim] < lengths[dim])
+        {
+            return;
+        }
+        indices[dim] = 0;
+    }
+}
+
+/// base class of the nodes of the expression templates
+/// @see hyper_array::binary_expression
+struct expression_base {};
+
+template <typename T>
+struct is_expression : std::is_base_of<expression_base, T> {};
+
+/// whether `T` can be an (non-scalar) operand of an expression
+/// i.e. an expression, a hyper_array::array or a hyper_array::array_view
+template <typename T>
+struct is_expression_operand : is_expression<T> {};
+
+/// whether `Left @ Right` is an element-wise expression (scalars can be combined with anything but scalars)
+template <typename Left, typename Right>
+struct are_expression_operands
+: std::integral_constant<bool,
+                         (is_expression_operand<Left>::value
+                          && (is_expression_operand<Right>::value || std::is_arithmetic<Right>::value))
+                         || (std::is_arithmetic<Left>::value && is_expression_operand<Right>::value)>
+{};
+
+}
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Allocators">
+/// common alignment values for hyper_array::aligned_allocator
+enum : std::size_t
+{
+    sse_alignment        = 16,  ///< 128-bit SIMD registers
+    avx_alignment        = 32,  ///< 256-bit SIMD registers
+    avx512_alignment     = 64,  ///< 512-bit SIMD registers
+    cache_line_alignment = 64   ///< most x86 and ARM cache lines
+};
+
+/// An allocator that returns memory aligned on an `Alignment`-byte boundary
+///
+/// Use it as hyper_array::array's `Allocator` in order to get an over-aligned `data()`
+/// e.g. for SIMD-friendly loops:
+/// @code
+///     hyper_array::array<float, 2, hyper_array::array_order::ROW_MAJOR,
+///                        hyper_array::aligned_allocator<float, hyper_array::avx_alignment>> arr{128, 128};
+///     assert(arr.is_aligned());
+/// @endcode
+template <typename ValueType, std::size_t Alignment = cache_line_alignment>
+class aligned_allocator
+{
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of 2");
+    static_assert(Alignment >= alignof(ValueType), "Alignment must not be less than alignof(ValueType)");
+
+public:
+
+    using value_type      = ValueType;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    /// guaranteed alignment of the allocated memory
+    static constexpr std::size_t alignment = Alignment;
+
+    template <typename Other>
+    struct rebind
+    {
+        using other = aligned_allocator<Other, Alignment>;
+    };
+
+    aligned_allocator() = default;
+
+    template <typename Other>
+    aligned_allocator(const aligned_allocator<Other, Alignment>&) noexcept
+    {}
+
+    value_type* allocate(const size_type count)
+    {
+        // over-allocate, align, then save the original address right before the aligned block
+        const size_type padding = Alignment - 1 + sizeof(void*);
+        if (count > (static_cast<size_type>(-1) - padding) / sizeof(value_type))
+        {
+            throw std::bad_alloc();
+        }
+
+        void* const       original = ::operator new(count * sizeof(value_type) + padding);
+        const std::uintptr_t first = reinterpret_cast<std::uintptr_t>(original) + sizeof(void*);
+        char* const        aligned = reinterpret_cast<char*>((first + Alignment - 1) & ~static_cast<std::uintptr_t>(Alignment - 1));
+        std::memcpy(aligned - sizeof(void*), &original, sizeof(void*));
+
+        return reinterpret_cast<value_type*>(aligned);
+    }
+
+    void deallocate(value_type* ptr, const size_type) noexcept
+    {
+        if (ptr != nullptr)
+        {
+            void* original;
+            std::memcpy(&original, reinterpret_cast<char*>(ptr) - sizeof(void*), sizeof(void*));
+            ::operator delete(original);
+        }
+    }
+
+    template <typename Other>
+    bool operator==(const aligned_allocator<Other, Alignment>&) const noexcept { return true;  }
+
+    template <typename Other>
+    bool operator!=(const aligned_allocator<Other, Alignment>&) const noexcept { return false; }
+};
+
+template <typename ValueType, std::size_t Alignment>
+constexpr std::size_t aligned_allocator<ValueType, Alignment>::alignment;
+
+/// An allocator that behaves like `Allocator`, but whose `size_type` is `SizeType`
+///
+/// hyper_array::array takes its `size_type` and `index_type` from its allocator (like the standard containers),
+/// e.g. 32-bit types halve the size of its lengths, coefficients and of the index arrays built from them:
+/// @code
+///     hyper_array::array<float, 3, hyper_array::array_order::ROW_MAJOR,
+///                        hyper_array::sized_allocator<std::allocator<float>, std::uint32_t>> arr{512, 512, 512};
+/// @endcode
+/// @see hyper_array::array32
+template <typename Allocator, typename SizeType>
+class sized_allocator : public Allocator
+{
+    static_assert(std::is_integral<SizeType>::value && std::is_unsigned<SizeType>::value,
+                  "SizeType must be an unsigned integer type");
+
+    using base_traits = std::allocator_traits<Allocator>;
+
+public:
+
+    using value_type      = typename base_traits::value_type;
+    using pointer         = typename base_traits::pointer;
+    using size_type       = SizeType;
+    using difference_type = typename std::make_signed<SizeType>::type;
+
+    template <typename Other>
+    struct rebind
+    {
+        using other = sized_allocator<typename base_traits::template rebind_alloc<Other>, SizeType>;
+    };
+
+    sized_allocator() = default;
+
+    sized_allocator(const Allocator& allocator) noexcept
+    : Allocator(allocator)
+    {}
+
+    template <typename OtherAllocator>
+    sized_allocator(const sized_allocator<OtherAllocator, SizeType>& other) noexcept
+    : Allocator(static_cast<const OtherAllocator&>(other))
+    {}
+
+    pointer allocate(const size_type count)
+    {
+        return base_traits::allocate(*this, count);
+    }
+
+    void deallocate(pointer ptr, const size_type count) noexcept
+    {
+        base_traits::deallocate(*this, ptr, count);
+    }
+};
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Slicing">
+template <
+    typename    ValueType,
+    std::size_t Dimensions,
+    array_order Order = array_order::ROW_MAJOR
+>
+class array_view;
+
+/// selects the `[start, stop)` indices of a dimension, every `step` indices
+/// @note when `step` is negative, the indices go from `start` down to `stop` (excluded)
+/// @see array_view::slice()
+struct range
+{
+    std::ptrdiff_t start;
+    std::ptrdiff_t stop;
+    std::ptrdiff_t step;
+
+    constexpr range(const std::ptrdiff_t start_, const std::ptrdiff_t stop_, const std::ptrdiff_t step_ = 1) noexcept
+    : start(start_)
+    , stop (stop_)
+    , step (step_)
+    {}
+};
+
+/// tag type for selecting all the indices of a dimension
+/// @see hyper_array::all
+struct all_t
+{};
+
+/// selects all the indices of a dimension
+/// @see array_view::slice()
+constexpr all_t all{};
+
+namespace internal
+{
+
+/// checks whether `T` can be used for slicing a dimension
+/// i.e. an index (reduces the number of dimensions), a range, or all
+template <typename T>
+using is_slice = std::integral_constant<
+    bool,
+    std::is_integral<typename std::remove_reference<T>::type>::value
+    || std::is_same<typename std::decay<T>::type, range>::value
+    || std::is_same<typename std::decay<T>::type, all_t>::value>;
+
+/// number of dimensions that remain after slicing
+/// i.e. those that are not sliced using a single index
+template <typename... Slices>
+constexpr std::size_t ct_sliced_dimensions()
+{
+    return ct_sum(std::size_t{0}, (std::is_integral<typename std::remove_reference<Slices>::type>::value ? std::size_t{0} : std::size_t{1})...);
+}
+
+/// the result of slicing a single dimension
+/// @note the selected indices aren't checked here, cf. array_view::slice()
+struct slice_info
+{
+    std::size_t    length;  ///< new length of the dimension
+    std::ptrdiff_t stride;  ///< new stride of the dimension
+    std::ptrdiff_t offset;  ///< offset of the first selected element
+    bool           keep;    ///< whether the dimension is kept
+    std::ptrdiff_t first;   ///< first selected index (if `length > 0`)
+    std::ptrdiff_t last;    ///< last selected index (if `length > 0`)
+};
+
+template <typename Index>
+enable_if_t<std::is_integral<Index>::value, slice_info>
+sliceDimension(const Index index, std::size_t, const std::ptrdiff_t stride) noexcept
+{
+    const std::ptrdiff_t i = static_cast<std::ptrdiff_t>(index);
+    return {1, stride, i * stride, false, i, i};
+}
+
+inline slice_info sliceDimension(all_t, const std::size_t length, const std::ptrdiff_t stride) noexcept
+{
+    return {length, stride, 0, true, 0, static_cast<std::ptrdiff_t>(length) - 1};
+}
+
+/// @throw std::invalid_argument if the step is 0
+inline slice_info sliceDimension(const range r, std::size_t, const std::ptrdiff_t stride)
+{
+    if (r.step == 0)
+    {
+        throw std::invalid_argument("hyper_array::range: the step can't be 0");
+    }
+    const std::ptrdiff_t span  = (r.step > 0) ? (r.stop - r.start) : (r.start - r.stop);
+    const std::ptrdiff_t step  = (r.step > 0) ? r.step : -r.step;
+    const std::size_t    count = (span > 0) ? static_cast<std::size_t>((span + step - 1) / step) : 0;
+    const std::ptrdiff_t last  = (count > 0) ? r.start + static_cast<std::ptrdiff_t>(count - 1) * r.step : r.start;
+
+    return {count, r.step * stride, (count > 0) ? r.start * stride : 0, true, r.start, last};
+}
+
+}
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Cursor">
+/// A multi-dimensional cursor: the current element's pointer *and* multi-index
+///
+/// Both are updated incrementally: moving to the next element costs one pointer increment, plus a "carry"
+/// whenever the end of a dimension is reached, and moving along a single dimension costs one pointer increment.
+/// This is cheaper than calling `operator()(i, j, k)` in nested loops, which recomputes the offset of each element.
+///
+/// Usage:
+/// @code
+///     for (auto c = arr.cursor(); c.valid(); ++c)
+///     {
+///         *c = c.index(0) * 100 + c.index(1);
+///     }
+/// @endcode
+template <typename ValueType, std::size_t Dimensions, array_order Order>
+class nd_cursor
+{
+public:
+
+    using value_type      = typename std::remove_const<ValueType>::type;
+    using difference_type = std::ptrdiff_t;
+    using pointer         = ValueType*;
+    using reference       = ValueType&;
+    using size_type       = std::size_t;
+    using indices_type    = ::std::array<size_type, Dimensions>;
+
+    /// cursor at index (0, 0, ..., 0)
+    nd_cursor(pointer                                         data,     ///< element at index (0, 0, ..., 0)
+              const ::std::array<size_type,       Dimensions>& lengths,
+              const ::std::array<difference_type, Dimensions>& coeffs)  ///< @see array_view::coeffs()
+    : _data     (data)
+    , _element  (data)
+    , _lengths  (lengths)
+    , _coeffs   (coeffs)
+    , _indices  ()
+    , _remaining(1)
+    {
+        for (size_type dim = 0; dim < Dimensions; ++dim)
+        {
+            _remaining *= _lengths[dim];
+        }
+    }
+
+    /// the current element
+    reference operator*()  const noexcept { return *_element; }
+    pointer   operator->() const noexcept { return  _element; }
+    pointer   get()        const noexcept { return  _element; }
+
+    /// the current element's multi-index
+    const indices_type& indices() const noexcept
+    {
+        return _indices;
+    }
+
+    /// the current element's index along `dim`
+    size_type index(const size_type dim) const noexcept
+    {
+        return _indices[dim];
+    }
+
+    const ::std::array<size_type, Dimensions>& lengths() const noexcept
+    {
+        return _lengths;
+    }
+
+    /// `false` once the cursor went past the last element (in `Order`)
+    /// @note moving along a single dimension with next()/prev()/move() doesn't update valid()
+    bool valid() const noexcept
+    {
+        return _remaining > 0;
+    }
+
+    /// moves to the next element in `Order`, i.e. in memory order when the data are dense
+    nd_cursor& operator++() noexcept
+    {
+        assert(valid());
+        --_remaining;
+        for (size_type rank = 0; rank < Dimensions; ++rank)
+        {
+            const size_type dim = internal::dimensionByRank<Order, Dimensions>(rank);
+            _element += _coeffs[dim];
+            if (++_indices[dim] < _lengths[dim])
+            {
+                return *this;
+            }
+            // carry
+            _element      -= static_cast<difference_type>(_lengths[dim]) * _coeffs[dim];
+            _indices[dim]  = 0;
+        }
+        return *this;
+    }
+
+    /// moves by one along `dim` (no carry, the index must stay within the dimension)
+    nd_cursor& next(const size_type dim) noexcept
+    {
+        assert(_indices[dim] + 1 < _lengths[dim]);
+        ++_indices[dim];
+        _element += _coeffs[dim];
+        return *this;
+    }
+
+    /// moves back by one along `dim` (no borrow, the index must stay within the dimension)
+    nd_cursor& prev(const size_type dim) noexcept
+    {
+        assert(_indices[dim] > 0);
+        --_indices[dim];
+        _element -= _coeffs[dim];
+        return *this;
+    }
+
+    /// moves by `steps` along `dim` (no carry, the index must stay within the dimension)
+    nd_cursor& move(const size_type dim, const difference_type steps) noexcept
+    {
+        assert((static_cast<difference_type>(_indices[dim]) + steps >= 0)
+            && (static_cast<size_type>(static_cast<difference_type>(_indices[dim]) + steps) < _lengths[dim]));
+        _indices[dim]  = static_cast<size_type>(static_cast<difference_type>(_indices[dim]) + steps);
+        _element      += steps * _coeffs[dim];
+        return *this;
+    }
+
+    /// moves to the element at `indices`
+    nd_cursor& seek(const indices_type& indices) noexcept
+    {
+        _indices = indices;
+        _element = _data;
+        size_type position = 0;
+        for (size_type rank = Dimensions; rank-- > 0;)
+        {
+            const size_type dim = internal::dimensionByRank<Order, Dimensions>(rank);
+            assert(indices[dim] < _lengths[dim]);
+            _element += static_cast<difference_type>(indices[dim]) * _coeffs[dim];
+            position  = position * _lengths[dim] + indices[dim];
+        }
+        size_type size = 1;
+        for (size_type dim = 0; dim < Dimensions; ++dim)
+        {
+            size *= _lengths[dim];
+        }
+        _remaining = size - position;
+        return *this;
+    }
+
+private:
+
+    pointer                                   _data;       ///< element at index (0, 0, ..., 0)
+    pointer                                   _element;    ///< current element
+    ::std::array<size_type,       Dimensions> _lengths;
+    ::std::array<difference_type, Dimensions> _coeffs;
+    indices_type                              _indices;    ///< current multi-index
+    size_type                                 _remaining;  ///< number of elements until the end, in `Order`
+};
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Index Conversion">
+namespace internal
+{
+
+#ifdef __SIZEOF_INT128__
+__extension__ typedef unsigned __int128 uint128;  // __extension__: no -Wpedantic warning
+#endif
+
+/// Divides unsigned integers by a divisor that is known at run-time, without any division instruction
+///
+/// cf. libdivide's "unsigned 64-bit" algorithm: `n / d` is computed as `mulhi(magic, n) >> shift`, with a fixup
+/// for the divisors whose magic number needs 65 bits, and a plain shift for the powers of 2.
+/// @note without 128-bit integers (e.g. MSVC), it falls back to plain divisions
+class fast_divider
+{
+public:
+
+    fast_divider() noexcept = default;
+
+    explicit fast_divider(const std::uint64_t divisor) noexcept
+    : _divisor(divisor)
+    {
+        assert(divisor > 0);
+#ifdef __SIZEOF_INT128__
+        unsigned log2 = 0;
+        while ((log2 < 63) && ((std::uint64_t{1} << (log2 + 1)) <= divisor))
+        {
+            ++log2;
+        }
+
+        if ((divisor & (divisor - 1)) == 0)
+        {
+            _magic = 0;
+            _shift = static_cast<std::uint8_t>(log2);
+            return;
+        }
+
+        const uint128       dividend = uint128{1} << (64 + log2);
+        std::uint64_t       magic    = static_cast<std::uint64_t>(dividend / divisor);
+        const std::uint64_t rem      = static_cast<std::uint64_t>(dividend % divisor);
+        if (divisor - rem < (std::uint64_t{1} << log2))
+        {
+            _shift = static_cast<std::uint8_t>(log2);
+        }
+        else
+        {
+            // the magic number needs 65 bits: keep its lower 64 bits, and add `n` back in divide()
+            magic += magic;
+            const std::uint64_t twiceRem = rem + rem;
+            if ((twiceRem >= divisor) || (twiceRem < rem))
+            {
+                magic += 1;
+            }
+            _shift = static_cast<std::uint8_t>(log2 | addMarker);
+        }
+        _magic = magic + 1;
+#endif
+    }
+
+    std::uint64_t divisor() const noexcept
+    {
+        return _divisor;
+    }
+
+    std::uint64_t divide(const std::uint64_t n) const noexcept
+    {
+#ifdef __SIZEOF_INT128__
+        if (_magic == 0)
+        {
+            return n >> _shift;
+        }
+        const std::uint64_t q = static_cast<std::uint64_t>((static_cast<uint128>(_magic) * n) >> 64);
+        if (_shift & addMarker)
+        {
+            return (((n - q) >> 1) + q) >> (_shift & shiftMask);
+        }
+        return q >> _shift;
+#else
+        return n / _divisor;
+#endif
+    }
+
+private:
+
+    enum : std::uint8_t
+    {
+        shiftMask = 0x3F,
+        addMarker = 0x40
+    };
+
+    std::uint64_t _divisor = 1;
+    std::uint64_t _magic   = 0;  ///< 0 for powers of 2
+    std::uint8_t  _shift   = 0;
+};
+
+}
+
+/// Converts offsets (i.e. positions in a dense array, laid out according to `Order`) into multi-indices,
+/// without any division
+///
+/// The magic numbers of the divisions by the array's lengths are computed once, in the constructor,
+/// then each conversion costs `Dimensions - 1` multiplications.
+///
+/// Usage:
+/// @code
+///     const auto it = std::max_element(arr.begin(), arr.end());
+///     const hyper_array::index_unraveler<3> unraveler{arr.lengths()};
+///     const std::array<std::size_t, 3> where = unraveler(it - arr.begin());  // arr(where[0], where[1], where[2]) == *it
+/// @endcode
+/// @see array::multiIndex()
+template <std::size_t Dimensions, array_order Order = array_order::ROW_MAJOR>
+class index_unraveler
+{
+public:
+
+    using size_type    = std::size_t;
+    using indices_type = ::std::array<size_type, Dimensions>;
+
+    template <typename SizeType>
+    explicit index_unraveler(const ::std::array<SizeType, Dimensions>& lengths)
+    {
+        for (size_type dim = 0; dim < Dimensions; ++dim)
+        {
+            _dividers[dim] = internal::fast_divider{(lengths[dim] > 0) ? static_cast<std::uint64_t>(lengths[dim]) : 1};
+        }
+    }
+
+    /// the multi-index of the element at `offset`
+    indices_type operator()(const size_type offset) const noexcept
+    {
+        indices_type  indices;
+        std::uint64_t remaining = offset;
+        for (size_type rank = 0; rank + 1 < Dimensions; ++rank)
+        {
+            const size_type     dim      = internal::dimensionByRank<Order, Dimensions>(rank);
+            const std::uint64_t quotient = _dividers[dim].divide(remaining);
+            indices[dim] = static_cast<size_type>(remaining - quotient * _dividers[dim].divisor());
+            remaining    = quotient;
+        }
+        indices[internal::dimensionByRank<Order, Dimensions>(Dimensions - 1)] = static_cast<size_type>(remaining);
+        return indices;
+    }
+
+    /// Batched version of operator(): writes the multi-index of each offset of `[first, last)` to `out`
+    /// @return the end of the output range
+    template <typename InputIterator, typename OutputIterator>
+    OutputIterator operator()(InputIterator first, const InputIterator last, OutputIterator out) const
+    {
+        for (; first != last; ++first, ++out)
+        {
+            *out = (*this)(static_cast<size_type>(*first));
+        }
+        return out;
+    }
+
+private:
+
+    ::std::array<internal::fast_divider, Dimensions> _dividers;
+};
+// </editor-fold>
+
+/// A multi-dimensional array
+/// Inspired by [orca_array](https://github.com/astrobiology/orca_array)
+template <
+    typename    ValueType,                              ///< elements' type
+    std::size_t Dimensions,                             ///< number of dimensions
+    array_order Order     = array_order::ROW_MAJOR,     ///< storage order
+    typename    Allocator = std::allocator<ValueType>   ///< allocates the data array
+>
+class array
+{
+    // Types ///////////////////////////////////////////////////////////////////////////////////////
+
+public:
+
+    // <editor-fold defaultstate="collapsed" desc="STL-like types">
+    // from <array>
+    using value_type             = ValueType;
+    using pointer                = value_type*;
+    using const_pointer          = const value_type*;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using iterator               = value_type*;
+    using const_iterator         = const value_type*;
+    using size_type              = typename std::allocator_traits<Allocator>::size_type;  ///< @see sized_allocator
+    using difference_type        = std::ptrdiff_t;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    // others
+    using array_type             = array<value_type, Dimensions, Order, Allocator>;
+    using index_type             = size_type;
+    using allocator_type         = Allocator;
+    // </editor-fold>
+
+    static_assert(std::is_unsigned<size_type>::value, "Allocator::size_type must be an unsigned integer type");
+
+    static_assert(std::is_same<typename std::allocator_traits<allocator_type>::value_type, value_type>::value,
+                  "Allocator::value_type must be the same as ValueType");
+
+private:
+
+    using deleter_type           = internal::allocator_deleter<allocator_type>;
+    using data_owner_type        = std::unique_ptr<value_type[], deleter_type>;
+
+    // Attributes //////////////////////////////////////////////////////////////////////////////////
+
+    // <editor-fold desc="Class Attributes">
+private:
+    // ::std::array's are used here mainly (only?) because they are initializable
+    // from `std::initializer_list` and they support move semantics
+    // cf. hyper_array::array's constructors
+    // also ::std::array seem to introduce no overhead over the data they hold
+    // i.e. sizeof(::std::array<Type, Length>) == sizeof(Type) * Length
+
+    /// number of elements in each dimension
+    ::std::array<size_type, Dimensions> _lengths;
+
+    /// coefficients to use when computing the index
+    /// @see at()
+    ::std::array<size_type, Dimensions> _coeffs;
+
+    /// total number of elements in the data array
+    size_type _size;
+
+    /// handles the lifecycle of the dynamically allocated data array
+    /// The user doesn't need to access it directly
+    /// If the user needs access to the allocated array, they can use data()
+    /// @note the deleter holds the allocator
+    data_owner_type _dataOwner;
+    // </editor-fold>
+
+    // methods /////////////////////////////////////////////////////////////////////////////////////
+
+public:
+
+    // <editor-fold defaultstate="collapsed" desc="Constructors">
+    /// would it make sense to create an array without specifying the dimension lengths ?
+    array() = delete;
+
+    /// copy-constructor
+    array(const array_type& other)
+    : _lengths   (other._lengths)
+    , _coeffs    (other._coeffs)
+    , _size      (other._size)
+    , _dataOwner {other.cloneData(
+                      std::allocator_traits<allocator_type>::select_on_container_copy_construction(
+                          other.get_allocator()))}
+    {}
+
+    /// move constructor
+    array(array_type&& other)
+    : _lengths   (std::move(other._lengths))
+    , _coeffs    (std::move(other._coeffs))
+    , _size      (other._size)
+    , _dataOwner {std::move(other._dataOwner)}
+    {}
+
+    /// Creates a copy of a hyper array that uses another order (and/or allocator)
+    /// e.g. for exchanging data with Fortran code
+    ///
+    /// `(*this)(i, j, ...) == other(i, j, ...)` for all indices.
+    /// The conversion uses a cache-oblivious copy, cf. hyper_array::copy()
+    template <
+        array_order OtherOrder,
+        typename    OtherAllocator,
+        typename = internal::enable_if_t<
+            !std::is_same<array<value_type, Dimensions, OtherOrder, OtherAllocator>, array_type>::value,
+            void>
+    >
+    explicit array(const array<value_type, Dimensions, OtherOrder, OtherAllocator>& other,
+                   const allocator_type& allocator = allocator_type())
+    : array(uninitialized, other.lengths(), allocator)
+    {
+        copy(other.view(), view());
+    }
+
+    /// Creates a hyper array from the result of an element-wise expression
+    /// e.g. `hyper_array::array<double, 2> c = a + 2.0 * b;`
+    /// @see hyper_array::evaluate()
+    template <
+        typename Expression,
+        typename = internal::enable_if_t<internal::is_expression<Expression>::value, void>
+    >
+    array(const Expression& expression, const allocator_type& allocator = allocator_type())
+    : array(uninitialized, expression.lengths(), allocator)
+    {
+        evaluate(expression, view());
+    }
+
+    /// the usual way of constructing hyper arrays
+    /// @throw std::length_error if a length, or the number of elements, can't be represented by `size_type`
+    template <
+        typename... DimensionLengths,
+        typename = internal::enable_if_t<
+            (sizeof...(DimensionLengths) == Dimensions) && internal::are_integral<DimensionLengths...>::value,
+            void>
+    >
+    array(DimensionLengths... dimensionLengths)
+    : _lengths   (internal::convertLengths<size_type>(::std::array<std::uint64_t, Dimensions>{{static_cast<std::uint64_t>(dimensionLengths)...}}))
+    , _coeffs    (internal::computeIndexCoeffs<size_type, Dimensions, Order>(_lengths))
+    , _size      (computeDataSize(_lengths))
+    , _dataOwner {allocateData(_size, allocator_type())}
+    {}
+
+    /// Creates a hyper array whose elements are left uninitialized
+    /// e.g. because they are about to be overwritten
+    ///
+    /// @note for trivial types, the memory is not touched at all, which means that
+    ///       page faults (and NUMA first-touch placement) happen in the thread that writes the data
+    template <
+        typename... DimensionLengths,
+        typename = internal::enable_if_t<
+            (sizeof...(DimensionLengths) == Dimensions) && internal::are_integral<DimensionLengths...>::value,
+            void>
+    >
+    array(uninitialized_t, DimensionLengths... dimensionLengths)
+    : array(uninitialized, internal::convertLengths<size_type>(::std::array<std::uint64_t, Dimensions>{{static_cast<std::uint64_t>(dimensionLengths)...}}))
+    {}
+
+    /// Creates a hyper array whose elements are left uninitialized
+    /// @see array(uninitialized_t, DimensionLengths...)
+    array(uninitialized_t,
+          ::std::array<size_type, Dimensions> lengths,  ///< length of each dimension
+          const allocator_type& allocator = allocator_type()  ///< allocates/releases the data array
+    )
+    : _lengths   (std::move(lengths))
+    , _coeffs    (internal::computeIndexCoeffs<size_type, Dimensions, Order>(_lengths))
+    , _size      (computeDataSize(_lengths))
+    , _dataOwner {allocateData(_size, allocator, uninitialized)}
+    {}
+
+    /// Creates a hyper array whose elements are left uninitialized, from lengths of another type
+    /// @throw std::length_error if a length can't be represented by `size_type`
+    template <
+        typename OtherSizeType,
+        typename = internal::enable_if_t<!std::is_same<OtherSizeType, size_type>::value, void>
+    >
+    array(uninitialized_t,
+          const ::std::array<OtherSizeType, Dimensions>& lengths,
+          const allocator_type& allocator = allocator_type()
+    )
+    : array(uninitialized, internal::convertLengths<size_type>(lengths), allocator)
+    {}
+
+    /// Creates a new hyper array from "raw data"
+    ///
+    /// @note `*this` will maintain ownership of `rawData`
+    ///       unless e.g. data are `std::move`d from it
+    /// @note `rawData` must have been allocated (and its elements constructed) using `allocator`
+    ///       or using `new[]` in case of the default `std::allocator`
+    array(::std::array<size_type, Dimensions> lengths,  ///< length of each dimension
+          value_type* rawData = nullptr,  ///< raw data
+                                          ///< must contain `computeDataSize(lengths)` elements
+                                          ///< if `nullptr`, a new data array will be allocated
+          const allocator_type& allocator = allocator_type()  ///< allocates/releases the data array
+    )
+    : _lengths   (std::move(lengths))
+    , _coeffs    (internal::computeIndexCoeffs<size_type, Dimensions, Order>(lengths))
+    , _size      (computeDataSize(_lengths))
+    , _dataOwner {rawData == nullptr ? allocateData(_size, allocator)
+                                     : data_owner_type{rawData, deleter_type{allocator, _size}}}
+    {
+        assert(is_aligned());
+    }
+
+    /// Creates a new hyper array from an initializer list
+    array(::std::array<size_type, Dimensions> lengths,  ///< length of each dimension
+          std::initializer_list<value_type>   values,   ///< {the initializer list}
+          const value_type& defaultValue      = {},     ///< default value, in case `values.size() < size()`
+          const allocator_type& allocator     = allocator_type()  ///< allocates/releases the data array
+    )
+    : _lengths   (std::move(lengths))
+    , _coeffs    (internal::computeIndexCoeffs<size_type, Dimensions, Order>(lengths))
+    , _size      (computeDataSize(_lengths))
+    , _dataOwner {allocateData(_size, allocator)}
+    {
+        if (values.size() <= size())
+        {
+            std::copy(values.begin(),
+                      values.end(),
+                      _dataOwner.get());
+
+            // fill any remaining number of uninitialized elements with the default value
+            if (values.size() < size())
+            {
+                std::fill(_dataOwner.get() + values.size(),
+                          _dataOwner.get() + size(),
+                          defaultValue);
+            }
+        }
+        else
+        {
+            assert(false);
+        }
+    }
+    // </editor-fold>
+
+    // <editor-fold defaultstate="collapsed" desc="Assignment Operators">
+    /// copy assignment
+    array_type& operator=(const array_type& other)
+    {
+        // the allocator follows the same propagation rules as the standard containers'
+        const bool propagate = std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value;
+
+        _dataOwner = other.cloneData(propagate ? other.get_allocator() : get_allocator());
+        _lengths   = other._lengths;
+        _coeffs    = other._coeffs;
+        _size      = other._size;
+
+        return *this;
+    }
+
+    /// move assignment
+    /// @note the allocator follows the same propagation rules as the standard containers':
+    ///       when it isn't propagated and it isn't equal to `other`'s, the elements are moved one by one
+    array_type& operator=(array_type&& other)
+    {
+        moveAssign(other, typename std::allocator_traits<allocator_type>::propagate_on_container_move_assignment{});
+
+        return *this;
+    }
+
+    /// evaluates an element-wise expression into the array, in a single pass
+    /// @note the array is reallocated if its lengths differ from the expression's
+    ///       (the expression is evaluated before the current elements are released, i.e. it can read them)
+    /// @see hyper_array::evaluate()
+    template <typename Expression>
+    internal::enable_if_t<internal::is_expression<Expression>::value, array_type&>
+    operator=(const Expression& expression)
+    {
+        if (!internal::equalLengths(_lengths, expression.lengths()))
+        {
+            array_type result{uninitialized, expression.lengths(), get_allocator()};
+            evaluate(expression, result.view());
+            *this = std::move(result);
+            return *this;
+        }
+        evaluate(expression, view());
+
+        return *this;
+    }
+
+    /// element-wise compound assignments, e.g. `a += b * c;` (evaluated in a single pass)
+    /// @throw std::invalid_argument if `operand` would broadcast the array, i.e. change its lengths
+    template <typename Operand>
+    internal::enable_if_t<internal::are_expression_operands<array_type, Operand>::value, array_type&>
+    operator+=(const Operand& operand)
+    {
+        evaluate(view() + operand, view());
+        return *this;
+    }
+
+    /// @see operator+=()
+    template <typename Operand>
+    internal::enable_if_t<internal::are_expression_operands<array_type, Operand>::value, array_type&>
+    operator-=(const Operand& operand)
+    {
+        evaluate(view() - operand, view());
+        return *this;
+    }
+
+    /// @see operator+=()
+    template <typename Operand>
+    internal::enable_if_t<internal::are_expression_operands<array_type, Operand>::value, array_type&>
+    operator*=(const Operand& operand)
+    {
+        evaluate(view() * operand, view());
+        return *this;
+    }
+
+    /// @see operator+=()
+    template <typename Operand>
+    internal::enable_if_t<internal::are_expression_operands<array_type, Operand>::value, array_type&>
+    operator/=(const Operand& operand)
+    {
+        evaluate(view() / operand, view());
+        return *this;
+    }
+    // </editor-fold>
+
+    // <editor-fold defaultstate="collapsed" desc="Whole-Array Iterators">
+    // from <array>
+          iterator         begin()         noexcept { return iterator(data());                }
+    const_iterator         begin()   const noexcept { return const_iterator(data());          }
+          iterator         end()           noexcept { return iterator(data() + size());       }
+    const_iterator         end()     const noexcept { return const_iterator(data() + size()); }
+          reverse_iterator rbegin()        noexcept { return reverse_iterator(end());         }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end());   }
+          reverse_iterator rend()          noexcept { return reverse_iterator(begin());       }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+    const_iterator         cbegin()  const noexcept { return const_iterator(data());          }
+    const_iterator         cend()    const noexcept { return const_iterator(data() + size()); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end());   }
+    const_reverse_iterator crend()   const noexcept { return const_reverse_iterator(begin()); }
+    // </editor-fold>
+
+    // <editor-fold defaultstate="collapsed" desc="Template Arguments">
+    /// number of dimensions
+    static constexpr size_type   dimensions() noexcept { return Dimensions; }
+    /// the convention used for arranging the elements
+    static constexpr array_order order()      noexcept { return Order;      }
+    /// guaranteed alignment (in bytes) of data()
+    static constexpr std::size_t alignment()  noexcept { return internal::allocator_alignment<allocator_type>::value; }
+    // </editor-fold>
+
+    /// Returns a copy of the allocator that is used for the data array
+    allocator_type get_allocator() const noexcept
+    {
+        return _dataOwner.get_deleter().allocator();
+    }
+
+    /// Returns the length of a given dimension at run-time
+    size_type length(const std::size_t dimensionIndex) const
+    {
+        assert(dimensionIndex < Dimensions);
+
+        return _lengths[dimensionIndex];
+    }
+
+    /// Returns a reference to the _lengths array
+    const ::std::array<size_type, Dimensions>& lengths() const noexcept
+    {
+        return _lengths;
+    }
+
+    /// Returns the given dimension's coefficient (used for computing the "linear" index)
+    size_type coeff(const std::size_t coeffIndex) const
+    {
+        assert(coeffIndex < Dimensions);
+
+        return _coeffs[coeffIndex];
+    }
+
+    /// Returns a reference to the _coeffs array
+    const ::std::array<size_type, Dimensions>& coeffs() const noexcept
+    {
+        return _coeffs;
+    }
+
+    /// Returns the total number of elements in data
+    size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    /// Returns a pointer to the allocated data array
+    /// @note the compiler is told that the pointer is aligned on an alignment()-byte boundary
+    value_type* data() noexcept
+    {
+        return internal::assume_aligned<alignment()>(_dataOwner.get());
+    }
+
+    /// `const` version of data()
+    const value_type* data() const noexcept
+    {
+        return internal::assume_aligned<alignment()>(_dataOwner.get());
+    }
+
+    /// checks that data() is actually aligned on an alignment()-byte boundary
+    bool is_aligned() const noexcept
+    {
+        return internal::is_aligned(_dataOwner.get(), alignment());
+    }
+
+    /// Returns a view over the whole array
+    array_view<value_type, Dimensions, Order> view() noexcept
+    {
+        return *this;
+    }
+
+    /// `const` version of view()
+    array_view<const value_type, Dimensions, Order> view() const noexcept
+    {
+        return *this;
+    }
+
+    /// Returns a cursor at index (0, 0, ..., 0)
+    /// @see nd_cursor
+    nd_cursor<value_type, Dimensions, Order> cursor() noexcept
+    {
+        return view().cursor();
+    }
+
+    /// `const` version of cursor()
+    nd_cursor<const value_type, Dimensions, Order> cursor() const noexcept
+    {
+        return view().cursor();
+    }
+
+    /// Returns a view over a subset of the elements, without copying anything
+    /// @see array_view::slice()
+    template <typename... Slices>
+    auto slice(Slices... slices)
+    -> decltype(std::declval<array_view<value_type, Dimensions, Order>>().slice(slices...))
+    {
+        return view().slice(slices...);
+    }
+
+    /// `const` version of slice()
+    template <typename... Slices>
+    auto slice(Slices... slices) const
+    -> decltype(std::declval<array_view<const value_type, Dimensions, Order>>().slice(slices...))
+    {
+        return view().slice(slices...);
+    }
+
+    /// Returns a view whose dimensions are reordered, without copying anything
+    /// @see array_view::permute()
+    template <typename... Axes>
+    array_view<value_type, Dimensions, Order> permute(Axes... axes)
+    {
+        return view().permute(axes...);
+    }
+
+    /// `const` version of permute()
+    template <typename... Axes>
+    array_view<const value_type, Dimensions, Order> permute(Axes... axes) const
+    {
+        return view().permute(axes...);
+    }
+
+    /// Returns a view whose dimensions are in reverse order, without copying anything
+    /// @see array_view::transpose()
+    array_view<value_type, Dimensions, Order> transpose()
+    {
+        return view().transpose();
+    }
+
+    /// `const` version of transpose()
+    array_view<const value_type, Dimensions, Order> transpose() const
+    {
+        return view().transpose();
+    }
+
+    /// Returns a read-only view where the elements are repeated along the broadcast dimensions, without copying anything
+    /// @see array_view::broadcast_to()
+    template <typename... Lengths>
+    auto broadcast_to(Lengths... lengths) const
+    -> decltype(std::declval<array_view<const value_type, Dimensions, Order>>().broadcast_to(lengths...))
+    {
+        return view().broadcast_to(lengths...);
+    }
+
+    /// Returns the element at index `idx` in the data array
+    value_type& operator[](const index_type idx)
+    {
+        return _dataOwner[idx];
+    }
+
+    /// `const` version of operator[]
+    const value_type& operator[](const index_type idx) const
+    {
+        return _dataOwner[idx];
+    }
+
+    /// Returns the element at the given index tuple
+    /// Usage:
+    /// @code
+    ///     hyper_array::array<double, 3> arr(4, 5, 6);
+    ///     arr.at(3, 1, 4) = 3.14;
+    /// @endcode
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        value_type&>
+    at(Indices... indices)
+    {
+        return _dataOwner[rawIndex_checkBounds(indices...)];
+    }
+
+    /// `const` version of at()
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        const value_type&>
+    at(Indices... indices) const
+    {
+        return _dataOwner[rawIndex_checkBounds(indices...)];
+    }
+
+    /// Unchecked version of at()
+    /// Usage:
+    /// @code
+    ///     hyper_array::array<double, 3> arr(4, 5, 6);
+    ///     arr(3, 1, 4) = 3.14;
+    /// @endcode
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        value_type&>
+    operator()(Indices... indices)
+    {
+        return _dataOwner[rawIndex_noChecks({{static_cast<index_type>(indices)...}})];
+    }
+
+    /// `const` version of operator()
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        const value_type&>
+    operator()(Indices... indices) const
+    {
+        return _dataOwner[rawIndex_noChecks({{static_cast<index_type>(indices)...}})];
+    }
+
+    /// returns the actual index of the element in the data array
+    /// Usage:
+    /// @code
+    ///     hyper_array::array<int, 3> arr(4, 5, 6);
+    ///     assert(&arr.at(3, 1, 4) == &arr.data()[arr.rawIndex(3, 1, 4)]);
+    /// @endcode
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        index_type>
+    rawIndex(Indices... indices) const
+    {
+        return rawIndex_checkBounds(indices...);
+    }
+
+    /// Inverse of rawIndex() (a.k.a. "unravel index"): returns the multi-index of the element at `offset` from data()
+    /// e.g. `arr.multiIndex(std::max_element(arr.begin(), arr.end()) - arr.begin())`
+    /// @note index_unraveler avoids the divisions when converting many offsets
+    ::std::array<index_type, Dimensions> multiIndex(index_type offset) const
+    {
+        assert(offset < size());
+
+        ::std::array<index_type, Dimensions> indices;
+        for (std::size_t rank = 0; rank < Dimensions; ++rank)
+        {
+            const std::size_t dim = internal::dimensionByRank<Order, Dimensions>(rank);
+            indices[dim] = offset % _lengths[dim];
+            offset       = offset / _lengths[dim];
+        }
+        return indices;
+    }
+
+private:
+
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        ::std::array<index_type, Dimensions>>
+    validateIndexRanges(Indices... indices) const
+    {
+        return internal::validateIndices<index_type>(_lengths, indices...);
+    }
+
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        index_type>
+    rawIndex_checkBounds(Indices... indices) const
+    {
+        return rawIndex_noChecks(validateIndexRanges(indices...));
+    }
+
+    constexpr
+    index_type
+    rawIndex_noChecks(const ::std::array<index_type, Dimensions>& indexArray) const noexcept
+    {
+        /* https://www.codecogs.com/latex/eqneditor.php
+           \begin{cases}
+           I_{actual} &= \sum_{i=0}^{N-1} {C_i \cdot I_i}                  \\
+                                                                           \\
+           I_{actual} &: \text{actual index of the data in the data array} \\
+           N          &: \text{Dimensions}                                 \\
+           C_i        &: \text{\_coeffs[i]}                                \\
+           I_i        &: \text{indexArray[i]}
+           \end{cases}
+        */
+        return internal::ct_inner_product(_coeffs, 0,
+                                          indexArray, 0,
+                                          Dimensions,
+                                          static_cast<index_type>(0),
+                                          internal::ct_plus<index_type>,
+                                          internal::ct_prod<index_type>);
+    }
+
+    /// computes the total number of elements in a data array
+    /// @throw std::length_error if it can't be represented by `size_type`
+    static
+    size_type
+    computeDataSize(const ::std::array<size_type, Dimensions>& dimensionLengths)
+    {
+        // an empty dimension makes the array empty, however large the other ones are
+        for (std::size_t i = 0; i < Dimensions; ++i)
+        {
+            if (dimensionLengths[i] == 0)
+            {
+                return 0;
+            }
+        }
+
+        size_type size = 1;
+        for (std::size_t i = 0; i < Dimensions; ++i)
+        {
+            if (size > std::numeric_limits<size_type>::max() / dimensionLengths[i])
+            {
+                throw std::length_error("hyper_array::array: the number of elements overflows size_type");
+            }
+            size = static_cast<size_type>(size * dimensionLengths[i]);
+        }
+        return size;
+    }
+
+    static
+    data_owner_type allocateData(const size_type elementCount, const allocator_type& allocator)
+    {
+        return data_owner_type{deleter_type::allocate(allocator, elementCount),
+                               deleter_type{allocator, elementCount}};
+    }
+
+    static
+    data_owner_type allocateData(const size_type elementCount, const allocator_type& allocator, uninitialized_t)
+    {
+        return data_owner_type{deleter_type::allocate(allocator, elementCount, uninitialized),
+                               deleter_type{allocator, elementCount}};
+    }
+
+    data_owner_type cloneData(const allocator_type& allocator) const
+    {
+        // allocate the new data container and copy data to it
+        return data_owner_type{deleter_type::clone(allocator, _dataOwner.get(), size()),
+                               deleter_type{allocator, size()}};
+    }
+
+    /// move assignment, when the allocator is propagated: `other`'s data (and allocator) are taken over
+    void moveAssign(array_type& other, std::true_type)
+    {
+        _lengths   = std::move(other._lengths);
+        _coeffs    = std::move(other._coeffs);
+        _size      = other._size;
+        _dataOwner = std::move(other._dataOwner);
+    }
+
+    /// move assignment, when the allocator isn't propagated:
+    /// `other`'s data is only taken over if it can be released by this array's allocator
+    void moveAssign(array_type& other, std::false_type)
+    {
+        const allocator_type allocator = get_allocator();
+        value_type* const    data      = ((allocator == other.get_allocator()) || (other._dataOwner == nullptr))
+                                       ? other._dataOwner.release()
+                                       : deleter_type::clone(allocator, std::make_move_iterator(other._dataOwner.get()), other._size);
+
+        _lengths   = other._lengths;
+        _coeffs    = other._coeffs;
+        _size      = other._size;
+        _dataOwner = data_owner_type{data, deleter_type{allocator, _size}};
+    }
+
+};
+
+/// hyper_array::array with 32-bit `size_type` and `index_type`
+/// @see sized_allocator
+template <typename ValueType, std::size_t Dimensions, array_order Order = array_order::ROW_MAJOR>
+using array32 = array<ValueType, Dimensions, Order, sized_allocator<std::allocator<ValueType>, std::uint32_t>>;
+
+/// Computes the strides of a dense array whose dimensions are padded
+/// i.e. the strides of a `paddedLengths` array laid out according to `Order`
+///
+/// Usage:
+/// @code
+///     // 480x640 image whose rows are 768-element long (e.g. aligned/padded "pitch")
+///     hyper_array::array_view<float, 2> image{pixels, {{480, 640}}, hyper_array::padded_strides<hyper_array::array_order::ROW_MAJOR>({{480, 768}})};
+/// @endcode
+template <array_order Order, std::size_t Dimensions>
+::std::array<std::ptrdiff_t, Dimensions> padded_strides(const ::std::array<std::size_t, Dimensions>& paddedLengths) noexcept
+{
+    return internal::toStrides(internal::computeIndexCoeffs<std::size_t, Dimensions, Order>(paddedLengths));
+}
+
+/// A non-owning multi-dimensional view over an existing data array
+///
+/// It provides the same element access and iteration semantics as hyper_array::array
+/// over memory that is owned by someone else (e.g. a network buffer, a memory-mapped file,
+/// another library, a hyper_array::array...).
+/// The view doesn't allocate or release anything, and is cheap to copy.
+///
+/// `ValueType` can be `const`-qualified in order to create read-only views.
+///
+/// Usage:
+/// @code
+///     float* buffer = receive(...);
+///     hyper_array::array_view<float, 3> view{buffer, 4, 5, 6};
+///     view(3, 1, 4) = 3.14f;
+/// @endcode
+template <
+    typename    ValueType,   ///< elements' type
+    std::size_t Dimensions,  ///< number of dimensions
+    array_order Order        ///< storage order, used for computing the default coefficients and the iteration order
+>
+class array_view
+{
+    // Types ///////////////////////////////////////////////////////////////////////////////////////
+
+public:
+
+    // <editor-fold defaultstate="collapsed" desc="STL-like types">
+    using value_type             = typename std::remove_const<ValueType>::type;
+    using element_type           = ValueType;
+    using pointer                = element_type*;
+    using const_pointer          = const element_type*;
+    using reference              = element_type&;
+    using const_reference        = const element_type&;
+    using iterator               = internal::strided_iterator<element_type, Dimensions, Order>;
+    using const_iterator         = internal::strided_iterator<const element_type, Dimensions, Order>;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    // others
+    using view_type              = array_view<element_type, Dimensions, Order>;
+    using index_type             = std::size_t;      ///< type of the indices along each dimension
+    using offset_type            = difference_type;  ///< type of the offsets from data(), cf. rawIndex()
+    // </editor-fold>
+
+    // Attributes //////////////////////////////////////////////////////////////////////////////////
+
+    // <editor-fold desc="Class Attributes">
+private:
+
+    /// number of elements in each dimension
+    ::std::array<size_type, Dimensions> _lengths;
+
+    /// coefficients (a.k.a. strides, in number of elements) to use when computing the index
+    /// @note they can be negative, or not follow `Order`
+    ::std::array<difference_type, Dimensions> _coeffs;
+
+    /// total number of elements in the view
+    size_type _size;
+
+    /// element at index (0, 0, ..., 0)
+    /// @note not owned by the view
+    pointer _data;
+    // </editor-fold>
+
+    // methods /////////////////////////////////////////////////////////////////////////////////////
+
+public:
+
+    // <editor-fold defaultstate="collapsed" desc="Constructors">
+    array_view() = delete;
+
+    /// Creates a view over a dense data array, laid out according to `Order`
+    template <
+        typename... DimensionLengths,
+        typename = internal::enable_if_t<
+            (sizeof...(DimensionLengths) == Dimensions) && internal::are_integral<DimensionLengths...>::value,
+            void>
+    >
+    array_view(pointer data, DimensionLengths... dimensionLengths)
+    : array_view(data, ::std::array<size_type, Dimensions>{{static_cast<size_type>(dimensionLengths)...}})
+    {}
+
+    /// Creates a view over a dense data array, laid out according to `Order`
+    array_view(pointer data,                                ///< first element
+               const ::std::array<size_type, Dimensions>& lengths  ///< length of each dimension
+    )
+    : array_view(data, lengths, internal::toStrides(internal::computeIndexCoeffs<size_type, Dimensions, Order>(lengths)))
+    {}
+
+    /// Creates a view over a strided data array
+    ///
+    /// Strides are arbitrary: e.g. they can describe padded dimensions (cf. padded_strides()),
+    /// subarrays, transposed or reversed (i.e. negative strides) dimensions...
+    array_view(pointer data,                                        ///< element at index (0, 0, ..., 0)
+               const ::std::array<size_type,       Dimensions>& lengths,  ///< length of each dimension
+               const ::std::array<difference_type, Dimensions>& strides   ///< distance (in elements) between two
+                                                                          ///< consecutive indices of each dimension
+    )
+    : _lengths (lengths)
+    , _coeffs  (strides)
+    , _size    (internal::ct_accumulate(_lengths, 0, Dimensions, static_cast<size_type>(1), internal::ct_prod<size_type>))
+    , _data    (data)
+    {}
+
+    /// Creates a view over the whole hyper array
+    template <typename Allocator>
+    array_view(array<value_type, Dimensions, Order, Allocator>& other)
+    : array_view(other.data(), internal::convertLengths<size_type>(other.lengths()), internal::toStrides(other.coeffs()))
+    {}
+
+    /// Creates a read-only view over the whole hyper array
+    template <
+        typename Allocator,
+        typename = internal::enable_if_t<std::is_const<element_type>::value, Allocator>
+    >
+    array_view(const array<value_type, Dimensions, Order, Allocator>& other)
+    : array_view(other.data(), internal::convertLengths<size_type>(other.lengths()), internal::toStrides(other.coeffs()))
+    {}
+
+    /// Creates a read-only view from a read-write one
+    template <
+        typename OtherValueType,
+        typename = internal::enable_if_t<std::is_same<const OtherValueType, element_type>::value, void>
+    >
+    array_view(const array_view<OtherValueType, Dimensions, Order>& other)
+    : array_view(other.data(), other.lengths(), other.coeffs())
+    {}
+    // </editor-fold>
+
+    // <editor-fold defaultstate="collapsed" desc="Whole-View Iterators">
+    // iteration follows `Order`, i.e. the memory order in case of dense views
+          iterator         begin()   const noexcept { return iterator(_data, _lengths, _coeffs, 0, _size);           }
+          iterator         end()     const noexcept { return iterator(_data, _lengths, _coeffs, _size, _size);       }
+          reverse_iterator rbegin()  const noexcept { return reverse_iterator(end());                                }
+          reverse_iterator rend()    const noexcept { return reverse_iterator(begin());                              }
+    const_iterator         cbegin()  const noexcept { return const_iterator(_data, _lengths, _coeffs, 0, _size);     }
+    const_iterator         cend()    const noexcept { return const_iterator(_data, _lengths, _coeffs, _size, _size); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(cend());                         }
+    const_reverse_iterator crend()   const noexcept { return const_reverse_iterator(cbegin());                       }
+    // </editor-fold>
+
+    // <editor-fold defaultstate="collapsed" desc="Template Arguments">
+    /// number of dimensions
+    static constexpr size_type   dimensions() noexcept { return Dimensions; }
+    /// the convention used for arranging the elements
+    static constexpr array_order order()      noexcept { return Order;      }
+    // </editor-fold>
+
+    /// Returns the length of a given dimension at run-time
+    size_type length(const size_type dimensionIndex) const
+    {
+        assert(dimensionIndex < Dimensions);
+
+        return _lengths[dimensionIndex];
+    }
+
+    /// Returns a reference to the _lengths array
+    const ::std::array<size_type, Dimensions>& lengths() const noexcept
+    {
+        return _lengths;
+    }
+
+    /// Returns the given dimension's coefficient (used for computing the "linear" index)
+    difference_type coeff(const size_type coeffIndex) const
+    {
+        assert(coeffIndex < Dimensions);
+
+        return _coeffs[coeffIndex];
+    }
+
+    /// Returns a reference to the _coeffs array
+    const ::std::array<difference_type, Dimensions>& coeffs() const noexcept
+    {
+        return _coeffs;
+    }
+
+    /// Returns the total number of elements in the view
+    size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    /// checks whether the elements are densely packed according to `Order`
+    /// i.e. if [data(), data() + size()) contains exactly the view's elements
+    bool is_contiguous() const noexcept
+    {
+        return _coeffs == internal::toStrides(internal::computeIndexCoeffs<size_type, Dimensions, Order>(_lengths));
+    }
+
+    /// Returns a pointer to the element at index (0, 0, ..., 0)
+    pointer data() const noexcept
+    {
+        return _data;
+    }
+
+    /// Returns a cursor at index (0, 0, ..., 0)
+    /// @see nd_cursor
+    nd_cursor<element_type, Dimensions, Order> cursor() const noexcept
+    {
+        return {_data, _lengths, _coeffs};
+    }
+
+    /// Returns the element at offset `offset` from data()
+    /// @see rawIndex()
+    reference operator[](const offset_type offset) const
+    {
+        return _data[offset];
+    }
+
+    /// Returns the element at the given index tuple
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        reference>
+    at(Indices... indices) const
+    {
+        return _data[rawIndex_checkBounds(indices...)];
+    }
+
+    /// Unchecked version of at()
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        reference>
+    operator()(Indices... indices) const
+    {
+        return _data[rawIndex_noChecks({{static_cast<offset_type>(indices)...}})];
+    }
+
+    /// Returns a view over a subset of the elements (a.k.a. hyperslab), without copying anything
+    ///
+    /// Each dimension is sliced using either:
+    ///   - a single index, which removes the dimension from the resulting view
+    ///   - a hyper_array::range of indices, with an optional (possibly negative) step
+    ///   - hyper_array::all, which keeps all the indices
+    ///
+    /// Usage:
+    /// @code
+    ///     using hyper_array::range;
+    ///     using hyper_array::all;
+    ///     // equivalent to NumPy's `arr[2:10, :, 5]` and `arr[::-1, 0, 1:7:2]`
+    ///     auto window   = view.slice(range(2, 10), all, 5);
+    ///     auto reversed = view.slice(range(view.length(0) - 1, -1, -1), 0, range(1, 7, 2));
+    /// @endcode
+    /// @note the selected indices are checked according to HYPER_ARRAY_CONFIG_Bounds_Check
+    /// @throw std::invalid_argument if the step of a range is 0
+    template <typename... Slices>
+    internal::enable_if_t<
+        (sizeof...(Slices) == Dimensions) && internal::are_all_true<internal::is_slice<Slices>::value...>::value,
+        array_view<element_type, internal::ct_sliced_dimensions<Slices...>(), Order>>
+    slice(Slices... slices) const
+    {
+        static_assert(internal::ct_sliced_dimensions<Slices...>() > 0,
+                      "slicing all the dimensions using single indices results in a single element, use operator() instead");
+
+        return sliceImpl<internal::ct_sliced_dimensions<Slices...>()>(internal::make_index_sequence<Dimensions>(), slices...);
+    }
+
+    /// Returns a view whose dimensions are reordered, without copying anything
+    /// i.e. the i-th dimension of the result is the `axes[i]`-th dimension of `*this`
+    /// @note use materialize() in order to get a dense array
+    /// @note the axes are checked according to HYPER_ARRAY_CONFIG_Bounds_Check
+    view_type permute(const ::std::array<size_type, Dimensions>& axes) const
+    {
+        ::std::array<size_type, Dimensions> dimensions;
+        dimensions.fill(Dimensions);
+        internal::validateIndexRanges(dimensions, axes);
+
+        ::std::array<size_type,       Dimensions> lengths;
+        ::std::array<difference_type, Dimensions> strides;
+        ::std::array<bool,            Dimensions> used{};
+        for (size_type i = 0; i < Dimensions; ++i)
+        {
+            assert(!used[axes[i]]);  // axes must be a permutation
+            used[axes[i]] = true;
+            lengths[i]    = _lengths[axes[i]];
+            strides[i]    = _coeffs[axes[i]];
+        }
+        return {_data, lengths, strides};
+    }
+
+    /// variadic version of permute()
+    /// Usage:
+    /// @code
+    ///     auto hwc = chw.permute(1, 2, 0);  // (channel, height, width) -> (height, width, channel)
+    /// @endcode
+    template <typename... Axes>
+    internal::enable_if_t<
+        (sizeof...(Axes) == Dimensions) && internal::are_integral<Axes...>::value,
+        view_type>
+    permute(Axes... axes) const
+    {
+        return permute(::std::array<size_type, Dimensions>{{static_cast<size_type>(axes)...}});
+    }
+
+    /// Returns a view whose dimensions are in reverse order, without copying anything
+    /// i.e. `transpose()(i, j, k) == (*this)(k, j, i)`
+    view_type transpose() const
+    {
+        ::std::array<size_type, Dimensions> axes;
+        for (size_type i = 0; i < Dimensions; ++i)
+        {
+            axes[i] = Dimensions - 1 - i;
+        }
+        return permute(axes);
+    }
+
+    /// Returns a view where two dimensions are swapped, without copying anything
+    /// @note the axes are checked according to HYPER_ARRAY_CONFIG_Bounds_Check
+    view_type swap_axes(const size_type axis1, const size_type axis2) const
+    {
+        internal::validateIndexRanges(::std::array<size_type, 2>{{Dimensions, Dimensions}},
+                                      ::std::array<size_type, 2>{{axis1, axis2}});
+
+        ::std::array<size_type, Dimensions> axes;
+        for (size_type i = 0; i < Dimensions; ++i)
+        {
+            axes[i] = i;
+        }
+        std::swap(axes[axis1], axes[axis2]);
+        return permute(axes);
+    }
+
+    /// Returns a read-only view of `lengths`, where the elements are repeated along the broadcast dimensions,
+    /// without copying anything (cf. NumPy's `broadcast_to()`)
+    ///
+    /// The dimensions are aligned on the last one: each of the view's dimensions must either have the same
+    /// length as the corresponding dimension of `lengths`, or a length of 1, in which case its stride is 0.
+    /// The missing leading dimensions also get a stride of 0.
+    ///
+    /// Usage:
+    /// @code
+    ///     hyper_array::array<double, 1> row{640};
+    ///     auto rows = row.broadcast_to(480, 640);  // rows(i, j) == row(j)
+    /// @endcode
+    /// @note elementwise expressions broadcast their operands implicitly, e.g. `image - row`
+    template <std::size_t NewDimensions>
+    array_view<const value_type, NewDimensions, Order> broadcast_to(const ::std::array<size_type, NewDimensions>& lengths) const
+    {
+        static_assert(NewDimensions >= Dimensions, "cannot broadcast to fewer dimensions");
+
+        constexpr std::size_t lead = NewDimensions - Dimensions;  // number of new leading dimensions
+        ::std::array<difference_type, NewDimensions> strides{};
+        for (size_type i = 0; i < Dimensions; ++i)
+        {
+            assert((_lengths[i] == lengths[lead + i]) || (_lengths[i] == 1));
+            strides[lead + i] = (_lengths[i] == lengths[lead + i]) ? _coeffs[i] : 0;
+        }
+        return {_data, lengths, strides};
+    }
+
+    /// variadic version of broadcast_to()
+    template <typename... Lengths>
+    internal::enable_if_t<
+        (sizeof...(Lengths) >= Dimensions) && internal::are_integral<Lengths...>::value,
+        array_view<const value_type, sizeof...(Lengths), Order>>
+    broadcast_to(Lengths... lengths) const
+    {
+        return broadcast_to(::std::array<size_type, sizeof...(Lengths)>{{static_cast<size_type>(lengths)...}});
+    }
+
+    /// returns the offset of the element from data()
+    /// @note the offset can be negative in case of negative strides
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        offset_type>
+    rawIndex(Indices... indices) const
+    {
+        return rawIndex_checkBounds(indices...);
+    }
+
+private:
+
+    template <std::size_t SlicedDimensions, std::size_t... Dims, typename... Slices>
+    array_view<element_type, SlicedDimensions, Order> sliceImpl(internal::index_sequence<Dims...>, Slices... slices) const
+    {
+        const ::std::array<internal::slice_info, Dimensions> infos = {{
+            internal::sliceDimension(slices, _lengths[Dims], _coeffs[Dims])...
+        }};
+
+        // the first and last selected indices of each dimension must be within its range
+        // (negative indices are converted into huge ones, the dimensions where nothing is selected always pass)
+        ::std::array<size_type,     Dimensions> checkedLengths;
+        ::std::array<std::uint64_t, Dimensions> firsts;
+        ::std::array<std::uint64_t, Dimensions> lasts;
+        for (std::size_t i = 0; i < Dimensions; ++i)
+        {
+            const bool selected = (infos[i].length > 0);
+            checkedLengths[i] = selected ? _lengths[i] : 1;
+            firsts[i]         = selected ? static_cast<std::uint64_t>(infos[i].first) : 0;
+            lasts[i]          = selected ? static_cast<std::uint64_t>(infos[i].last)  : 0;
+        }
+        internal::validateIndexRanges(checkedLengths, firsts);
+        internal::validateIndexRanges(checkedLengths, lasts);
+
+        ::std::array<size_type,       SlicedDimensions> lengths{};
+        ::std::array<difference_type, SlicedDimensions> strides{};
+        difference_type offset = 0;
+        size_type       k      = 0;
+        for (const internal::slice_info& info : infos)
+        {
+            offset += info.offset;
+            if (info.keep)
+            {
+                lengths[k] = info.length;
+                strides[k] = info.stride;
+                ++k;
+            }
+        }
+
+        return {_data + offset, lengths, strides};
+    }
+
+    template <typename... Indices>
+    offset_type rawIndex_checkBounds(Indices... indices) const
+    {
+        internal::validateIndices<index_type>(_lengths, indices...);
+        return rawIndex_noChecks({{static_cast<offset_type>(indices)...}});
+    }
+
+    constexpr
+    offset_type
+    rawIndex_noChecks(const ::std::array<offset_type, Dimensions>& indexArray) const noexcept
+    {
+        // same as array::rawIndex_noChecks(), using signed arithmetic
+        return internal::ct_inner_product(_coeffs, 0,
+                                          indexArray, 0,
+                                          Dimensions,
+                                          static_cast<offset_type>(0),
+                                          internal::ct_plus<offset_type>,
+                                          internal::ct_prod<offset_type>);
+    }
+};
+
+// <editor-fold defaultstate="collapsed" desc="Copying">
+namespace internal
+{
+
+/// the dimension whose stride is the smallest (in absolute value)
+/// i.e. the dimension to iterate over in the innermost loop
+/// @note dimensions of length 1 are ignored
+template <std::size_t Dimensions>
+std::size_t innermostDimension(const ::std::array<std::size_t,    Dimensions>& lengths,
+                               const ::std::array<std::ptrdiff_t, Dimensions>& strides) noexcept
+{
+    std::size_t result = Dimensions - 1;
+    for (std::size_t i = Dimensions; i-- > 0;)
+    {
+        const std::ptrdiff_t stride     = (strides[i] < 0)      ? -strides[i]      : strides[i];
+        const std::ptrdiff_t bestStride = (strides[result] < 0) ? -strides[result] : strides[result];
+        if ((lengths[i] > 1) && ((lengths[result] <= 1) || (stride < bestStride)))
+        {
+            result = i;
+        }
+    }
+    return result;
+}
+
+/// maximum number of elements along each side of the blocks that are copied directly by obliviousCopy()
+/// (a block of both the source and the destination should fit in the L1 cache; 512 bytes per side
+/// measured best with src/benchmark.cpp)
+template <typename ValueType>
+constexpr std::size_t copyBlockLength() noexcept
+{
+    return (512 / sizeof(ValueType) < 8)  ? 8
+         : (512 / sizeof(ValueType) > 64) ? 64
+         : 512 / sizeof(ValueType);
+}
+
+/// copies a 2D block of `lengthA x lengthB` elements
+///
+/// The block is recursively split in halves (along its longest side) until it is small enough,
+/// which makes the copy cache-oblivious: both the source and the destination are accessed
+/// in a cache-friendly way at every level of the memory hierarchy, whatever their strides.
+/// @see Frigo et al., "Cache-Oblivious Algorithms"
+template <typename DstType, typename SrcType>
+void obliviousCopy(DstType* dst, const std::ptrdiff_t dstStrideA, const std::ptrdiff_t dstStrideB,
+                   SrcType* src, const std::ptrdiff_t srcStrideA, const std::ptrdiff_t srcStrideB,
+                   const std::size_t lengthA, const std::size_t lengthB)
+{
+    constexpr std::size_t block = copyBlockLength<typename std::remove_const<SrcType>::type>();
+
+    if ((lengthA > block) && (lengthA >= lengthB))
+    {
+        const std::size_t    half   = lengthA / 2;
+        const std::ptrdiff_t offset = static_cast<std::ptrdiff_t>(half);
+        obliviousCopy(dst,                       dstStrideA, dstStrideB,
+                      src,                       srcStrideA, srcStrideB, half,           lengthB);
+        obliviousCopy(dst + offset * dstStrideA, dstStrideA, dstStrideB,
+                      src + offset * srcStrideA, srcStrideA, srcStrideB, lengthA - half, lengthB);
+    }
+    else if (lengthB > block)
+    {
+        const std::size_t    half   = lengthB / 2;
+        const std::ptrdiff_t offset = static_cast<std::ptrdiff_t>(half);
+        obliviousCopy(dst,                       dstStrideA, dstStrideB,
+                      src,                       srcStrideA, srcStrideB, lengthA, half);
+        obliviousCopy(dst + offset * dstStrideB, dstStrideA, dstStrideB,
+                      src + offset * srcStrideB, srcStrideA, srcStrideB, lengthA, lengthB - half);
+    }
+    else
+    {
+        for (std::size_t b = 0; b < lengthB; ++b)
+        {
+            DstType* d = dst + static_cast<std::ptrdiff_t>(b) * dstStrideB;
+            SrcType* s = src + static_cast<std::ptrdiff_t>(b) * srcStrideB;
+            for (std::size_t a = 0; a < lengthA; ++a)
+            {
+                d[static_cast<std::ptrdiff_t>(a) * dstStrideA] = s[static_cast<std::ptrdiff_t>(a) * srcStrideA];
+            }
+        }
+    }
+}
+
+/// copies the elements of a view into another one that has the same lengths
+///
+/// The innermost loop runs along the destination's smallest stride. When the source's smallest stride
+/// is along another dimension (e.g. transposition, order conversion), these two dimensions are copied
+/// using a cache-oblivious algorithm.
+template <typename DstType, typename SrcType, std::size_t Dimensions, array_order DstOrder, array_order SrcOrder>
+void stridedCopy(const array_view<DstType, Dimensions, DstOrder>& dst,
+                 const array_view<SrcType, Dimensions, SrcOrder>& src)
+{
+    assert(dst.lengths() == src.lengths());
+
+    if (src.size() == 0)
+    {
+        return;
+    }
+
+    const std::size_t dimA = innermostDimension(dst.lengths(), dst.coeffs());  // contiguous in dst
+    const std::size_t dimB = innermostDimension(src.lengths(), src.coeffs());  // contiguous in src
+
+    // the outer loops iterate over the other dimensions
+    ::std::array<std::size_t, Dimensions> outerLengths = src.lengths();
+    outerLengths[dimA] = 1;
+    outerLengths[dimB] = 1;
+
+    // both outer views use the same order, so that they are iterated in lockstep
+    const array_view<DstType, Dimensions, DstOrder> dstOuter{dst.data(), outerLengths, dst.coeffs()};
+    const array_view<SrcType, Dimensions, DstOrder> srcOuter{src.data(), outerLengths, src.coeffs()};
+
+    const std::size_t lengthB = (dimA == dimB) ? 1 : src.length(dimB);
+    auto s = srcOuter.begin();
+    for (auto d = dstOuter.begin(); d != dstOuter.end(); ++d, ++s)
+    {
+        obliviousCopy(&*d, dst.coeff(dimA), dst.coeff(dimB),
+                      &*s, src.coeff(dimA), src.coeff(dimB),
+                      src.length(dimA), lengthB);
+    }
+}
+
+}
+
+/// Copies the elements of `src` into `dst`, element (i, j, ...) to element (i, j, ...)
+///
+/// The copy is cache-oblivious, which makes it efficient for e.g. transposed or permuted views.
+/// @note `src` and `dst` must have the same lengths and must not overlap
+template <typename SrcType, typename DstType, std::size_t Dimensions, array_order SrcOrder, array_order DstOrder>
+void copy(const array_view<SrcType, Dimensions, SrcOrder>& src,
+          const array_view<DstType, Dimensions, DstOrder>& dst)
+{
+    internal::stridedCopy(dst, src);
+}
+
+/// Returns a dense hyper array containing a copy of the view's elements
+/// @see copy()
+///
+/// Usage:
+/// @code
+///     hyper_array::array<double, 2> transposed = hyper_array::materialize(matrix.transpose());
+/// @endcode
+template <
+    typename    Allocator = void,  ///< allocator of the new array, `void` means `std::allocator`
+    typename    ValueType,
+    std::size_t Dimensions,
+    array_order Order
+>
+array<typename std::remove_const<ValueType>::type, Dimensions, Order,
+      typename std::conditional<std::is_void<Allocator>::value,
+                                std::allocator<typename std::remove_const<ValueType>::type>,
+                                Allocator>::type>
+materialize(const array_view<ValueType, Dimensions, Order>& view)
+{
+    using value_type = typename std::remove_const<ValueType>::type;
+    using alloc_type = typename std::conditional<std::is_void<Allocator>::value,
+                                                 std::allocator<value_type>,
+                                                 Allocator>::type;
+
+    array<value_type, Dimensions, Order, alloc_type> result{uninitialized, view.lengths()};
+    internal::stridedCopy(result.view(), view);
+    return result;
+}
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="SIMD Kernels">
+namespace simd
+{
+
+/// instruction sets for which the kernels are implemented
+enum class instruction_set : int
+{
+    scalar = 0,
+    sse2   = 1,
+    avx2   = 2,  ///< AVX2 and FMA
+    avx512 = 3   ///< AVX-512F
+};
+
+/// comparisons implemented by compare()
+enum class comparison : int
+{
+    equal,
+    not_equal,
+    less,
+    less_equal,
+    greater,
+    greater_equal
+};
+
+}
+
+namespace internal
+{
+namespace simd
+{
+
+using ::hyper_array::simd::instruction_set;
+using ::hyper_array::simd::comparison;
+
+// operations of the binary kernels
+struct add_tag {};
+struct sub_tag {};
+struct mul_tag {};
+struct div_tag {};
+struct min_tag {};
+struct max_tag {};
+
+// scalar versions of the operations, also used for the last elements of the vectorized loops
+template <typename T> T scalarOp(add_tag, const T a, const T b) noexcept { return a + b; }
+template <typename T> T scalarOp(sub_tag, const T a, const T b) noexcept { return a - b; }
+template <typename T> T scalarOp(mul_tag, const T a, const T b) noexcept { return a * b; }
+template <typename T> T scalarOp(div_tag, const T a, const T b) noexcept { return a / b; }
+template <typename T> T scalarOp(min_tag, const T a, const T b) noexcept { return (a < b) ? a : b; }  // same as (v)minps/pd, NaN's included
+template <typename T> T scalarOp(max_tag, const T a, const T b) noexcept { return (a > b) ? a : b; }  // same as (v)maxps/pd, NaN's included
+
+template <typename T> T scalarFma(const T a, const T b, const T c) noexcept { return a * b + c; }
+
+template <typename T> T scalarAbs(const T a) noexcept { return std::abs(a); }
+
+/// @note `a <= b && b <= a` is used instead of `a == b`, which is false for NaN's as well
+template <comparison C, typename T>
+bool scalarCompare(const T a, const T b) noexcept
+{
+    return (C == comparison::equal)      ?  ((a <= b) && (b <= a))
+         : (C == comparison::not_equal)  ? !((a <= b) && (b <= a))
+         : (C == comparison::less)       ?  (a <  b)
+         : (C == comparison::less_equal) ?  (a <= b)
+         : (C == comparison::greater)    ?  (a >  b)
+         :                                  (a >= b);
+}
+
+/// stores the `count` lowest bits of a comparison mask as `bool`s (`count <= 16`)
+/// @note x86 only (i.e. little-endian), the scalar kernels store the results directly
+inline void storeMask(bool* out, const unsigned mask, const std::size_t count) noexcept
+{
+    for (std::size_t j = 0; j < count; j += 8)
+    {
+        // replicate the byte, keep bit k in byte k, then turn each non-zero byte into 1
+        const std::uint64_t bits  = ((mask >> j) & 0xFFu) * UINT64_C(0x0101010101010101) & UINT64_C(0x8040201008040201);
+        const std::uint64_t bytes = ((bits + UINT64_C(0x7F7F7F7F7F7F7F7F)) >> 7) & UINT64_C(0x0101010101010101);
+        std::memcpy(out + j, &bytes, (count - j < 8) ? (count - j) : 8);
+    }
+}
+
+/// pointers to the kernels of an instruction set
+template <typename T>
+struct kernel_table
+{
+    using binary_kernel  = void (*)(const T*, const T*, T*, std::size_t);
+    using ternary_kernel = void (*)(const T*, const T*, const T*, T*, std::size_t);
+    using unary_kernel   = void (*)(const T*, T*, std::size_t);
+    using compare_kernel = void (*)(const T*, const T*, bool*, std::size_t);
+
+    binary_kernel  add;
+    binary_kernel  sub;
+    binary_kernel  mul;
+    binary_kernel  div;
+    binary_kernel  min;
+    binary_kernel  max;
+    ternary_kernel fma;
+    unary_kernel   abs;
+    compare_kernel compare[6];  ///< indexed by hyper_array::simd::comparison
+};
+
+/*
+ * The kernels are generic loops over "vector" types that wrap the intrinsics of an instruction set:
+ *   value_type, reg, width, load(), store(), apply(tag, a, b), fma(a, b, c), abs(a), mask<comparison>(a, b)
+ * They are defined in each instruction set's namespace, in which the compiler is allowed to use that instruction set
+ * (cf. `#pragma GCC target`) whatever the compilation flags are.
+ */
+#define HYPER_ARRAY_SIMD_KERNELS                                                                        \
+    template <typename V, typename Tag>                                                                 \
+    void binaryLoop(const typename V::value_type* a, const typename V::value_type* b,                   \
+                    typename V::value_type* out, const std::size_t size) noexcept                       \
+    {                                                                                                   \
+        std::size_t i = 0;                                                                              \
+        for (; i + V::width <= size; i += V::width)                                                     \
+        {                                                                                               \
+            V::store(out + i, V::apply(Tag{}, V::load(a + i), V::load(b + i)));                         \
+        }                                                                                               \
+        for (; i < size; ++i)                                                                           \
+        {                                                                                               \
+            out[i] = scalarOp(Tag{}, a[i], b[i]);                                                       \
+        }                                                                                               \
+    }                                                                                                   \
+                                                                                                        \
+    template <typename V>                                                                               \
+    void fmaLoop(const typename V::value_type* a, const typename V::value_type* b,                      \
+                 const typename V::value_type* c, typename V::value_type* out,                          \
+                 const std::size_t size) noexcept                                                       \
+    {                                                                                                   \
+        std::size_t i = 0;                                                                              \
+        for (; i + V::width <= size; i += V::width)                                                     \
+        {                                                                                               \
+            V::store(out + i, V::fma(V::load(a + i), V::load(b + i), V::load(c + i)));                  \
+        }                                                                                               \
+        for (; i < size; ++i)                                                                           \
+        {                                                                                               \
+            out[i] = scalarFma(a[i], b[i], c[i]);                                                       \
+        }                                                                                               \
+    }                                                                                                   \
+                                                                                                        \
+    template <typename V>                                                                               \
+    void absLoop(const typename V::value_type* a, typename V::value_type* out,                          \
+                 const std::size_t size) noexcept                                                       \
+    {                                                                                                   \
+        std::size_t i = 0;                                                                              \
+        for (; i + V::width <= size; i += V::width)                                                     \
+        {                                                                                               \
+            V::store(out + i, V::abs(V::load(a + i)));                                                  \
+        }                                                                                               \
+        for (; i < size; ++i)                                                                           \
+        {                                                                                               \
+            out[i] = scalarAbs(a[i]);                                                                   \
+        }                                                                                               \
+    }                                                                                                   \
+                                                                                                        \
+    template <typename V, comparison C>                                                                 \
+    void compareLoop(const typename V::value_type* a, const typename V::value_type* b,                  \
+                     bool* out, const std::size_t size) noexcept                                        \
+    {                                                                                                   \
+        std::size_t i = 0;                                                                              \
+        for (; i + V::width <= size; i += V::width)                                                     \
+        {                                                                                               \
+            const unsigned mask = V::template mask<C>(V::load(a + i), V::load(b + i));                  \
+            if (V::width == 1)                                                                          \
+            {                                                                                           \
+                out[i] = (mask != 0);                                                                   \
+            }                                                                                           \
+            else                                                                                        \
+            {                                                                                           \
+                storeMask(out + i, mask, V::width);                                                     \
+            }                                                                                           \
+        }                                                                                               \
+        for (; i < size; ++i)                                                                           \
+        {                                                                                               \
+            out[i] = scalarCompare<C>(a[i], b[i]);                                                      \
+        }                                                                                               \
+    }                                                                                                   \
+                                                                                                        \
+    template <typename T>                                                                               \
+    const kernel_table<T>& table() noexcept                                                             \
+    {                                                                                                   \
+        using V = vector<T>;                                                                            \
+        static const kernel_table<T> kernels = {                                                        \
+            &binaryLoop<V, add_tag>, &binaryLoop<V, sub_tag>, &binaryLoop<V, mul_tag>,                  \
+            &binaryLoop<V, div_tag>, &binaryLoop<V, min_tag>, &binaryLoop<V, max_tag>,                  \
+            &fmaLoop<V>,                                                                                \
+            &absLoop<V>,                                                                                \
+            {&compareLoop<V, comparison::equal>,   &compareLoop<V, comparison::not_equal>,              \
+             &compareLoop<V, comparison::less>,    &compareLoop<V, comparison::less_equal>,             \
+             &compareLoop<V, comparison::greater>, &compareLoop<V, comparison::greater_equal>}          \
+        };                                                                                              \
+        return kernels;                                                                                 \
+    }
+
+namespace scalar
+{
+
+template <typename T>
+struct vector
+{
+    using value_type = T;
+    using reg        = T;
+    static constexpr std::size_t width = 1;
+
+    static reg  load (const T* p)                              noexcept { return *p; }
+    static void store(T* p, const reg x)                       noexcept { *p = x; }
+    template <typename Tag>
+    static reg  apply(Tag tag, const reg a, const reg b)       noexcept { return scalarOp(tag, a, b); }
+    static reg  fma  (const reg a, const reg b, const reg c)   noexcept { return scalarFma(a, b, c); }
+    static reg  abs  (const reg a)                             noexcept { return scalarAbs(a); }
+    template <comparison C>
+    static unsigned mask(const reg a, const reg b)             noexcept { return scalarCompare<C>(a, b) ? 1u : 0u; }
+};
+
+HYPER_ARRAY_SIMD_KERNELS
+
+}
+
+#if HYPER_ARRAY_SIMD_X86
+
+/// `_CMP_*` predicate of a comparison, for the AVX and AVX-512 comparison intrinsics
+constexpr int cmpPredicate(const comparison c) noexcept
+{
+    return (c == comparison::equal)      ? _CMP_EQ_OQ
+         : (c == comparison::not_equal)  ? _CMP_NEQ_UQ
+         : (c == comparison::less)       ? _CMP_LT_OQ
+         : (c == comparison::less_equal) ? _CMP_LE_OQ
+         : (c == comparison::greater)    ? _CMP_GT_OQ
+         :                                 _CMP_GE_OQ;
+}
+
+/// compile-time version of cmpPredicate() (the intrinsics require immediate values)
+template <comparison C>
+struct cmp_predicate : std::integral_constant<int, cmpPredicate(C)> {};
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("sse2"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+namespace sse2
+{
+
+template <typename T>
+struct vector;
+
+template <>
+struct vector<float>
+{
+    using value_type = float;
+    using reg        = __m128;
+    static constexpr std::size_t width = 4;
+
+    static reg  load (const float* p)                          noexcept { return _mm_loadu_ps(p); }
+    static void store(float* p, const reg x)                   noexcept { _mm_storeu_ps(p, x); }
+    static reg  apply(add_tag, const reg a, const reg b)       noexcept { return _mm_add_ps(a, b); }
+    static reg  apply(sub_tag, const reg a, const reg b)       noexcept { return _mm_sub_ps(a, b); }
+    static reg  apply(mul_tag, const reg a, const reg b)       noexcept { return _mm_mul_ps(a, b); }
+    static reg  apply(div_tag, const reg a, const reg b)       noexcept { return _mm_div_ps(a, b); }
+    static reg  apply(min_tag, const reg a, const reg b)       noexcept { return _mm_min_ps(a, b); }
+    static reg  apply(max_tag, const reg a, const reg b)       noexcept { return _mm_max_ps(a, b); }
+    static reg  fma  (const reg a, const reg b, const reg c)   noexcept { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+    static reg  abs  (const reg a)                             noexcept { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    template <comparison C>
+    static unsigned mask(const reg a, const reg b) noexcept
+    {
+        return static_cast<unsigned>(_mm_movemask_ps((C == comparison::equal)      ? _mm_cmpeq_ps (a, b)
+                                                   : (C == comparison::not_equal)  ? _mm_cmpneq_ps(a, b)
+                                                   : (C == comparison::less)       ? _mm_cmplt_ps (a, b)
+                                                   : (C == comparison::less_equal) ? _mm_cmple_ps (a, b)
+                                                   : (C == comparison::greater)    ? _mm_cmpgt_ps (a, b)
+                                                   :                                 _mm_cmpge_ps (a, b)));
+    }
+};
+
+template <>
+struct vector<double>
+{
+    using value_type = double;
+    using reg        = __m128d;
+    static constexpr std::size_t width = 2;
+
+    static reg  load (const double* p)                         noexcept { return _mm_loadu_pd(p); }
+    static void store(double* p, const reg x)                  noexcept { _mm_storeu_pd(p, x); }
+    static reg  apply(add_tag, const reg a, const reg b)       noexcept { return _mm_add_pd(a, b); }
+    static reg  apply(sub_tag, const reg a, const reg b)       noexcept { return _mm_sub_pd(a, b); }
+    static reg  apply(mul_tag, const reg a, const reg b)       noexcept { return _mm_mul_pd(a, b); }
+    static reg  apply(div_tag, const reg a, const reg b)       noexcept { return _mm_div_pd(a, b); }
+    static reg  apply(min_tag, const reg a, const reg b)       noexcept { return _mm_min_pd(a, b); }
+    static reg  apply(max_tag, const reg a, const reg b)       noexcept { return _mm_max_pd(a, b); }
+    static reg  fma  (const reg a, const reg b, const reg c)   noexcept { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+    static reg  abs  (const reg a)                             noexcept { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    template <comparison C>
+    static unsigned mask(const reg a, const reg b) noexcept
+    {
+        return static_cast<unsigned>(_mm_movemask_pd((C == comparison::equal)      ? _mm_cmpeq_pd (a, b)
+                                                   : (C == comparison::not_equal)  ? _mm_cmpneq_pd(a, b)
+                                                   : (C == comparison::less)       ? _mm_cmplt_pd (a, b)
+                                                   : (C == comparison::less_equal) ? _mm_cmple_pd (a, b)
+                                                   : (C == comparison::greater)    ? _mm_cmpgt_pd (a, b)
+                                                   :                                 _mm_cmpge_pd (a, b)));
+    }
+};
+
+HYPER_ARRAY_SIMD_KERNELS
+
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+#endif
+namespace avx2
+{
+
+template <typename T>
+struct vector;
+
+template <>
+struct vector<float>
+{
+    using value_type = float;
+    using reg        = __m256;
+    static constexpr std::size_t width = 8;
+
+    static reg  load (const float* p)                          noexcept { return _mm256_loadu_ps(p); }
+    static void store(float* p, const reg x)                   noexcept { _mm256_storeu_ps(p, x); }
+    static reg  apply(add_tag, const reg a, const reg b)       noexcept { return _mm256_add_ps(a, b); }
+    static reg  apply(sub_tag, const reg a, const reg b)       noexcept { return _mm256_sub_ps(a, b); }
+    static reg  apply(mul_tag, const reg a, const reg b)       noexcept { return _mm256_mul_ps(a, b); }
+    static reg  apply(div_tag, const reg a, const reg b)       noexcept { return _mm256_div_ps(a, b); }
+    static reg  apply(min_tag, const reg a, const reg b)       noexcept { return _mm256_min_ps(a, b); }
+    static reg  apply(max_tag, const reg a, const reg b)       noexcept { return _mm256_max_ps(a, b); }
+    static reg  fma  (const reg a, const reg b, const reg c)   noexcept { return _mm256_fmadd_ps(a, b, c); }
+    static reg  abs  (const reg a)                             noexcept { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    template <comparison C>
+    static unsigned mask(const reg a, const reg b)             noexcept { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, cmp_predicate<C>::value))); }
+};
+
+template <>
+struct vector<double>
+{
+    using value_type = double;
+    using reg        = __m256d;
+    static constexpr std::size_t width = 4;
+
+    static reg  load (const double* p)                         noexcept { return _mm256_loadu_pd(p); }
+    static void store(double* p, const reg x)                  noexcept { _mm256_storeu_pd(p, x); }
+    static reg  apply(add_tag, const reg a, const reg b)       noexcept { return _mm256_add_pd(a, b); }
+    static reg  apply(sub_tag, const reg a, const reg b)       noexcept { return _mm256_sub_pd(a, b); }
+    static reg  apply(mul_tag, const reg a, const reg b)       noexcept { return _mm256_mul_pd(a, b); }
+    static reg  apply(div_tag, const reg a, const reg b)       noexcept { return _mm256_div_pd(a, b); }
+    static reg  apply(min_tag, const reg a, const reg b)       noexcept { return _mm256_min_pd(a, b); }
+    static reg  apply(max_tag, const reg a, const reg b)       noexcept { return _mm256_max_pd(a, b); }
+    static reg  fma  (const reg a, const reg b, const reg c)   noexcept { return _mm256_fmadd_pd(a, b, c); }
+    static reg  abs  (const reg a)                             noexcept { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    template <comparison C>
+    static unsigned mask(const reg a, const reg b)             noexcept { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, cmp_predicate<C>::value))); }
+};
+
+HYPER_ARRAY_SIMD_KERNELS
+
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#endif
+namespace avx512
+{
+
+template <typename T>
+struct vector;
+
+template <>
+struct vector<float>
+{
+    using value_type = float;
+    using reg        = __m512;
+    static constexpr std::size_t width = 16;
+
+    static reg  load (const float* p)                          noexcept { return _mm512_loadu_ps(p); }
+    static void store(float* p, const reg x)                   noexcept { _mm512_storeu_ps(p, x); }
+    static reg  apply(add_tag, const reg a, const reg b)       noexcept { return _mm512_add_ps(a, b); }
+    static reg  apply(sub_tag, const reg a, const reg b)       noexcept { return _mm512_sub_ps(a, b); }
+    static reg  apply(mul_tag, const reg a, const reg b)       noexcept { return _mm512_mul_ps(a, b); }
+    static reg  apply(div_tag, const reg a, const reg b)       noexcept { return _mm512_div_ps(a, b); }
+    // the maskz versions avoid gcc's bogus -Wmaybe-uninitialized warnings in _mm512_min/max_ps
+    static reg  apply(min_tag, const reg a, const reg b)       noexcept { return _mm512_maskz_min_ps(0xFFFF, a, b); }
+    static reg  apply(max_tag, const reg a, const reg b)       noexcept { return _mm512_maskz_max_ps(0xFFFF, a, b); }
+    static reg  fma  (const reg a, const reg b, const reg c)   noexcept { return _mm512_fmadd_ps(a, b, c); }
+    static reg  abs  (const reg a)                             noexcept { return _mm512_abs_ps(a); }
+    template <comparison C>
+    static unsigned mask(const reg a, const reg b)             noexcept { return static_cast<unsigned>(_mm512_cmp_ps_mask(a, b, cmp_predicate<C>::value)); }
+};
+
+template <>
+struct vector<double>
+{
+    using value_type = double;
+    using reg        = __m512d;
+    static constexpr std::size_t width = 8;
+
+    static reg  load (const double* p)                         noexcept { return _mm512_loadu_pd(p); }
+    static void store(double* p, const reg x)                  noexcept { _mm512_storeu_pd(p, x); }
+    static reg  apply(add_tag, const reg a, const reg b)       noexcept { return _mm512_add_pd(a, b); }
+    static reg  apply(sub_tag, const reg a, const reg b)       noexcept { return _mm512_sub_pd(a, b); }
+    static reg  apply(mul_tag, const reg a, const reg b)       noexcept { return _mm512_mul_pd(a, b); }
+    static reg  apply(div_tag, const reg a, const reg b)       noexcept { return _mm512_div_pd(a, b); }
+    static reg  apply(min_tag, const reg a, const reg b)       noexcept { return _mm512_maskz_min_pd(0xFF, a, b); }
+    static reg  apply(max_tag, const reg a, const reg b)       noexcept { return _mm512_maskz_max_pd(0xFF, a, b); }
+    static reg  fma  (const reg a, const reg b, const reg c)   noexcept { return _mm512_fmadd_pd(a, b, c); }
+    static reg  abs  (const reg a)                             noexcept { return _mm512_abs_pd(a); }
+    template <comparison C>
+    static unsigned mask(const reg a, const reg b)             noexcept { return static_cast<unsigned>(_mm512_cmp_pd_mask(a, b, cmp_predicate<C>::value)); }
+};
+
+HYPER_ARRAY_SIMD_KERNELS
+
+}
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC pop_options
+#endif
+
+#endif  // HYPER_ARRAY_SIMD_X86
+
+#undef HYPER_ARRAY_SIMD_KERNELS
+
+/// the best instruction set that is supported by both the CPU and the OS
+inline instruction_set detectInstructionSet() noexcept
+{
+#if HYPER_ARRAY_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return instruction_set::avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        return instruction_set::avx2;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return instruction_set::sse2;
+    }
+#endif
+    return instruction_set::scalar;
+}
+
+/// the instruction set whose kernels are currently used
+/// @see hyper_array::simd::set_instruction_set()
+inline std::atomic<int>& activeInstructionSet() noexcept
+{
+    static std::atomic<int> isa{static_cast<int>(detectInstructionSet())};
+    return isa;
+}
+
+/// returns the kernels of the active instruction set
+template <typename T>
+const kernel_table<T>& kernels() noexcept
+{
+    static_assert(std::is_same<T, float>::value || std::is_same<T, double>::value,
+                  "the SIMD kernels are only implemented for float and double");
+
+#if HYPER_ARRAY_SIMD_X86
+    const instruction_set isa = static_cast<instruction_set>(activeInstructionSet().load(std::memory_order_relaxed));
+    if (isa == instruction_set::avx512)
+    {
+        return avx512::table<T>();
+    }
+    if (isa == instruction_set::avx2)
+    {
+        return avx2::table<T>();
+    }
+    if (isa == instruction_set::sse2)
+    {
+        return sse2::table<T>();
+    }
+#endif
+    return scalar::table<T>();
+}
+
+}
+}
+
+/// Element-wise kernels over contiguous `float` or `double` data, with SSE2, AVX2 and AVX-512 implementations
+///
+/// The implementation is selected at run-time (using CPUID), so that a single binary uses the best
+/// instruction set of the machine it runs on, whatever the compilation flags are.
+/// All the kernels but fma() give the same results on every instruction set.
+///
+/// @note `out` can be one of the inputs, but must not partially overlap them
+/// @see HYPER_ARRAY_CONFIG_SIMD
+namespace simd
+{
+
+/// the best instruction set that is supported by the machine
+inline instruction_set detected_instruction_set() noexcept
+{
+    static const instruction_set isa = internal::simd::detectInstructionSet();
+    return isa;
+}
+
+/// the instruction set that is used by the kernels (by default, detected_instruction_set())
+inline instruction_set active_instruction_set() noexcept
+{
+    return static_cast<instruction_set>(internal::simd::activeInstructionSet().load(std::memory_order_relaxed));
+}
+
+/// Selects the instruction set that is used by the kernels, e.g. for testing or benchmarking purposes
+/// @return the selected instruction set, i.e. `isa`, or detected_instruction_set() if `isa` isn't supported
+inline instruction_set set_instruction_set(const instruction_set isa) noexcept
+{
+    const instruction_set selected = (static_cast<int>(isa) <= static_cast<int>(detected_instruction_set()))
+                                   ? isa
+                                   : detected_instruction_set();
+    internal::simd::activeInstructionSet().store(static_cast<int>(selected), std::memory_order_relaxed);
+    return selected;
+}
+
+/// name of an instruction set, e.g. for logging
+inline const char* instruction_set_name(const instruction_set isa) noexcept
+{
+    return (isa == instruction_set::avx512) ? "AVX-512"
+         : (isa == instruction_set::avx2)   ? "AVX2"
+         : (isa == instruction_set::sse2)   ? "SSE2"
+         :                                    "scalar";
+}
+
+/// `out[i] = a[i] + b[i]`
+template <typename T>
+void add(const T* a, const T* b, T* out, const std::size_t size) noexcept { internal::simd::kernels<T>().add(a, b, out, size); }
+
+/// `out[i] = a[i] - b[i]`
+template <typename T>
+void sub(const T* a, const T* b, T* out, const std::size_t size) noexcept { internal::simd::kernels<T>().sub(a, b, out, size); }
+
+/// `out[i] = a[i] * b[i]`
+template <typename T>
+void mul(const T* a, const T* b, T* out, const std::size_t size) noexcept { internal::simd::kernels<T>().mul(a, b, out, size); }
+
+/// `out[i] = a[i] / b[i]`
+template <typename T>
+void div(const T* a, const T* b, T* out, const std::size_t size) noexcept { internal::simd::kernels<T>().div(a, b, out, size); }
+
+/// `out[i] = (a[i] < b[i]) ? a[i] : b[i]` (i.e. `b[i]` if either is NaN)
+template <typename T>
+void min(const T* a, const T* b, T* out, const std::size_t size) noexcept { internal::simd::kernels<T>().min(a, b, out, size); }
+
+/// `out[i] = (a[i] > b[i]) ? a[i] : b[i]` (i.e. `b[i]` if either is NaN)
+template <typename T>
+void max(const T* a, const T* b, T* out, const std::size_t size) noexcept { internal::simd::kernels<T>().max(a, b, out, size); }
+
+/// `out[i] = a[i] * b[i] + c[i]`
+/// @note the multiplication and the addition are fused (i.e. a single rounding) with AVX2 and AVX-512 only
+template <typename T>
+void fma(const T* a, const T* b, const T* c, T* out, const std::size_t size) noexcept { internal::simd::kernels<T>().fma(a, b, c, out, size); }
+
+/// `out[i] = |a[i]|`
+template <typename T>
+void abs(const T* a, T* out, const std::size_t size) noexcept { internal::simd::kernels<T>().abs(a, out, size); }
+
+/// `out[i] = a[i] <comparison> b[i]`
+/// @note comparisons with NaN's are false, except for `not_equal`
+template <typename T>
+void compare(const comparison c, const T* a, const T* b, bool* out, const std::size_t size) noexcept
+{
+    internal::simd::kernels<T>().compare[static_cast<int>(c)](a, b, out, size);
+}
+
+// same kernels, over whole hyper arrays (that must have the same lengths)
+
+template <typename T, std::size_t Dimensions, array_order Order, typename A, typename B, typename Out>
+void add(const array<T, Dimensions, Order, A>& a, const array<T, Dimensions, Order, B>& b, array<T, Dimensions, Order, Out>& out) noexcept
+{
+    assert((a.lengths() == b.lengths()) && (a.lengths() == out.lengths()));
+    add(a.data(), b.data(), out.data(), out.size());
+}
+
+template <typename T, std::size_t Dimensions, array_order Order, typename A, typename B, typename Out>
+void sub(const array<T, Dimensions, Order, A>& a, const array<T, Dimensions, Order, B>& b, array<T, Dimensions, Order, Out>& out) noexcept
+{
+    assert((a.lengths() == b.lengths()) && (a.lengths() == out.lengths()));
+    sub(a.data(), b.data(), out.data(), out.size());
+}
+
+template <typename T, std::size_t Dimensions, array_order Order, typename A, typename B, typename Out>
+void mul(const array<T, Dimensions, Order, A>& a, const array<T, Dimensions, Order, B>& b, array<T, Dimensions, Order, Out>& out) noexcept
+{
+    assert((a.lengths() == b.lengths()) && (a.lengths() == out.lengths()));
+    mul(a.data(), b.data(), out.data(), out.size());
+}
+
+template <typename T, std::size_t Dimensions, array_order Order, typename A, typename B, typename Out>
+void div(const array<T, Dimensions, Order, A>& a, const array<T, Dimensions, Order, B>& b, array<T, Dimensions, Order, Out>& out) noexcept
+{
+    assert((a.lengths() == b.lengths()) && (a.lengths() == out.lengths()));
+    div(a.data(), b.data(), out.data(), out.size());
+}
+
+template <typename T, std::size_t Dimensions, array_order Order, typename A, typename B, typename Out>
+void min(const array<T, Dimensions, Order, A>& a, const array<T, Dimensions, Order, B>& b, array<T, Dimensions, Order, Out>& out) noexcept
+{
+    assert((a.lengths() == b.lengths()) && (a.lengths() == out.lengths()));
+    min(a.data(), b.data(), out.data(), out.size());
+}
+
+template <typename T, std::size_t Dimensions, array_order Order, typename A, typename B, typename Out>
+void max(const array<T, Dimensions, Order, A>& a, const array<T, Dimensions, Order, B>& b, array<T, Dimensions, Order, Out>& out) noexcept
+{
+    assert((a.lengths() == b.lengths()) && (a.lengths() == out.lengths()));
+    max(a.data(), b.data(), out.data(), out.size());
+}
+
+template <typename T, std::size_t Dimensions, array_order Order, typename A, typename B, typename C, typename Out>
+void fma(const array<T, Dimensions, Order, A>& a, const array<T, Dimensions, Order, B>& b, const array<T, Dimensions, Order, C>& c,
+         array<T, Dimensions, Order, Out>& out) noexcept
+{
+    assert((a.lengths() == b.lengths()) && (a.lengths() == c.lengths()) && (a.lengths() == out.lengths()));
+    fma(a.data(), b.data(), c.data(), out.data(), out.size());
+}
+
+template <typename T, std::size_t Dimensions, array_order Order, typename A, typename Out>
+void abs(const array<T, Dimensions, Order, A>& a, array<T, Dimensions, Order, Out>& out) noexcept
+{
+    assert(a.lengths() == out.lengths());
+    abs(a.data(), out.data(), out.size());
+}
+
+template <typename T, std::size_t Dimensions, array_order Order, typename A, typename B, typename Out>
+void compare(const comparison c, const array<T, Dimensions, Order, A>& a, const array<T, Dimensions, Order, B>& b,
+             array<bool, Dimensions, Order, Out>& out) noexcept
+{
+    assert((a.lengths() == b.lengths()) && (a.lengths() == out.lengths()));
+    compare(c, a.data(), b.data(), out.data(), out.size());
+}
+
+}
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Expression Templates">
+/*
+ * Element-wise arithmetic between hyper arrays, views and scalars is lazily evaluated:
+ * expressions such as `a + 2.0 * b` only build a (small) tree of nodes, which is evaluated
+ * in a single loop once it is assigned to a hyper array (or evaluated into a view).
+ * i.e. no temporary arrays and a single pass over the data.
+ *
+ * Every node provides:
+ * - `value_type`, `dimensions()` and `lengths()` (scalars have no lengths and 0 dimensions)
+ * - `isLinear(denseStrides)`: whether all the operands are laid out according to `denseStrides`,
+ *   in which case `linear()[i]` returns the value of the i-th element in memory order
+ * - `row(indices, dim)[k]`: the value of the element at `indices` + k along dimension `dim`
+ *
+ * The operands of binary expressions are broadcast against each other, as in NumPy:
+ * their dimensions are aligned on the last one, and a dimension of length 1 (or a missing leading dimension)
+ * is repeated along the other operand's dimension, e.g. `a - mean` where `a` is {N, M} and `mean` is {M}.
+ * This is done by reading the repeated elements with a stride of 0, i.e. without expanding the operand.
+ */
+
+/// leaf of an expression: reads the elements of a (possibly strided) view
+template <typename ValueType, std::size_t Dimensions, array_order Order>
+class terminal_expression : public internal::expression_base
+{
+public:
+
+    using value_type   = ValueType;
+    using lengths_type = ::std::array<std::size_t, Dimensions>;
+
+    struct linear_evaluator
+    {
+        const value_type* data;
+
+        value_type operator[](const std::size_t i) const noexcept { return data[i]; }
+    };
+
+    struct row_evaluator
+    {
+        const value_type* data;
+        std::ptrdiff_t    stride;
+
+        value_type operator[](const std::size_t k) const noexcept { return data[static_cast<std::ptrdiff_t>(k) * stride]; }
+    };
+
+    explicit terminal_expression(const array_view<const value_type, Dimensions, Order>& view) noexcept
+    : _view(view)
+    {}
+
+    static constexpr std::size_t dimensions() noexcept { return Dimensions; }
+
+    const lengths_type& lengths() const noexcept { return _view.lengths(); }
+
+    bool isLinear(const ::std::array<std::ptrdiff_t, Dimensions>& denseStrides) const noexcept
+    {
+        return _view.coeffs() == denseStrides;
+    }
+
+    /// broadcast along leading dimensions
+    template <std::size_t ExpressionDimensions>
+    bool isLinear(const ::std::array<std::ptrdiff_t, ExpressionDimensions>&) const noexcept
+    {
+        return false;
+    }
+
+    linear_evaluator linear() const noexcept
+    {
+        return {_view.data()};
+    }
+
+    /// @note `indices` and `dim` refer to the dimensions of the (possibly broadcast) expression
+    template <std::size_t ExpressionDimensions>
+    row_evaluator row(const ::std::array<std::size_t, ExpressionDimensions>& indices, const std::size_t dim) const noexcept
+    {
+        static_assert(ExpressionDimensions >= Dimensions, "an operand cannot have more dimensions than its expression");
+
+        constexpr std::size_t lead = ExpressionDimensions - Dimensions;  // number of broadcast leading dimensions
+        std::ptrdiff_t offset = 0;
+        for (std::size_t i = 0; i < Dimensions; ++i)
+        {
+            // a dimension of length 1 is broadcast: its only index is 0
+            if (_view.length(i) != 1)
+            {
+                offset += _view.coeff(i) * static_cast<std::ptrdiff_t>(indices[lead + i]);
+            }
+        }
+        const bool broadcast = (dim + Dimensions < ExpressionDimensions) || (_view.length(dim - lead) == 1);
+        return {_view.data() + offset, broadcast ? 0 : _view.coeff(dim - lead)};
+    }
+
+private:
+
+    array_view<const value_type, Dimensions, Order> _view;
+};
+
+/// leaf of an expression: a scalar that is broadcast to every element
+template <typename ValueType>
+class scalar_expression : public internal::expression_base
+{
+public:
+
+    using value_type = ValueType;
+
+    struct evaluator
+    {
+        value_type value;
+
+        value_type operator[](const std::size_t) const noexcept { return value; }
+    };
+    using linear_evaluator = evaluator;
+    using row_evaluator    = evaluator;
+
+    explicit scalar_expression(const value_type& value)
+    : _value(value)
+    {}
+
+    static constexpr std::size_t dimensions() noexcept { return 0; }
+
+    template <typename Strides>
+    bool isLinear(const Strides&) const noexcept { return true; }
+
+    evaluator linear() const { return {_value}; }
+
+    template <typename Indices>
+    evaluator row(const Indices&, const std::size_t) const { return {_value}; }
+
+private:
+
+    value_type _value;
+};
+
+/// `function(operand)`, element-wise
+template <typename Function, typename Operand>
+class unary_expression : public internal::expression_base
+{
+public:
+
+    using value_type   = typename std::decay<
+                             decltype(std::declval<const Function&>()(std::declval<typename Operand::value_type>()))
+                         >::type;
+    using lengths_type = typename Operand::lengths_type;
+
+    template <typename OperandEvaluator>
+    struct evaluator
+    {
+        Function         function;
+        OperandEvaluator operand;
+
+        value_type operator[](const std::size_t i) const { return function(operand[i]); }
+    };
+    using linear_evaluator = evaluator<typename Operand::linear_evaluator>;
+    using row_evaluator    = evaluator<typename Operand::row_evaluator>;
+
+    unary_expression(const Function& function, const Operand& operand)
+    : _function(function)
+    , _operand (operand)
+    {}
+
+    static constexpr std::size_t dimensions() noexcept { return Operand::dimensions(); }
+
+    lengths_type lengths() const { return _operand.lengths(); }
+
+    template <typename Strides>
+    bool isLinear(const Strides& denseStrides) const noexcept { return _operand.isLinear(denseStrides); }
+
+    linear_evaluator linear() const { return {_function, _operand.linear()}; }
+
+    template <typename Indices>
+    row_evaluator row(const Indices& indices, const std::size_t dim) const { return {_function, _operand.row(indices, dim)}; }
+
+private:
+
+    Function _function;
+    Operand  _operand;
+};
+
+namespace internal
+{
+
+/// lengths of two operands broadcast against each other
+/// i.e. aligned on the last dimension, where a length of 1 (or a missing leading dimension) takes the other length
+/// @throw std::invalid_argument if the operands can't be broadcast against each other
+template <std::size_t LeftDimensions, std::size_t RightDimensions>
+::std::array<std::size_t, (LeftDimensions > RightDimensions) ? LeftDimensions : RightDimensions>
+broadcastLengths(const ::std::array<std::size_t, LeftDimensions>&  left,
+                 const ::std::array<std::size_t, RightDimensions>& right)
+{
+    constexpr std::size_t dimensions = (LeftDimensions > RightDimensions) ? LeftDimensions : RightDimensions;
+
+    ::std::array<std::size_t, dimensions> result;
+    for (std::size_t i = 0; i < dimensions; ++i)
+    {
+        const std::size_t l = (i + LeftDimensions  >= dimensions) ? left [i + LeftDimensions  - dimensions] : 1;
+        const std::size_t r = (i + RightDimensions >= dimensions) ? right[i + RightDimensions - dimensions] : 1;
+        if ((l != r) && (l != 1) && (r != 1))
+        {
+            throw std::invalid_argument("hyper_array: the operands' lengths can't be broadcast against each other");
+        }
+        result[i] = (l == 1) ? r : l;
+    }
+    return result;
+}
+
+/// lengths of a binary expression (i.e. those of its non-scalar operand(s), broadcast against each other)
+template <typename Left, typename Right>
+enable_if_t<(Right::dimensions() == 0), typename Left::lengths_type>
+expressionLengths(const Left& left, const Right&)
+{
+    return left.lengths();
+}
+
+template <typename Left, typename Right>
+enable_if_t<(Left::dimensions() == 0), typename Right::lengths_type>
+expressionLengths(const Left&, const Right& right)
+{
+    return right.lengths();
+}
+
+template <typename Left, typename Right>
+enable_if_t<(Left::dimensions() != 0) && (Right::dimensions() != 0),
+            ::std::array<std::size_t, (Left::dimensions() > Right::dimensions()) ? Left::dimensions() : Right::dimensions()>>
+expressionLengths(const Left& left, const Right& right)
+{
+    return broadcastLengths(left.lengths(), right.lengths());
+}
+
+/// whether an operand of a binary expression is broadcast to the expression's `lengths`
+template <typename Operand, typename Lengths>
+enable_if_t<(Operand::dimensions() == 0), bool>
+isBroadcast(const Operand&, const Lengths&) noexcept
+{
+    return false;
+}
+
+template <typename Operand, std::size_t Dimensions>
+enable_if_t<(Operand::dimensions() != 0), bool>
+isBroadcast(const Operand& operand, const ::std::array<std::size_t, Dimensions>& lengths)
+{
+    if (Operand::dimensions() != Dimensions)
+    {
+        return true;
+    }
+    for (std::size_t i = 0; i < Operand::dimensions(); ++i)
+    {
+        if (operand.lengths()[i] != lengths[i])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+}
+
+/// `function(left, right)`, element-wise
+template <typename Function, typename Left, typename Right>
+class binary_expression : public internal::expression_base
+{
+    static_assert((Left::dimensions() != 0) || (Right::dimensions() != 0),
+                  "at least one of the operands of an expression must be an array");
+
+public:
+
+    using value_type   = typename std::decay<
+                             decltype(std::declval<const Function&>()(std::declval<typename Left::value_type>(),
+                                                                      std::declval<typename Right::value_type>()))
+                         >::type;
+    using lengths_type = ::std::array<std::size_t, (Left::dimensions() > Right::dimensions()) ? Left::dimensions() : Right::dimensions()>;
+
+    template <typename LeftEvaluator, typename RightEvaluator>
+    struct evaluator
+    {
+        Function       function;
+        LeftEvaluator  left;
+        RightEvaluator right;
+
+        value_type operator[](const std::size_t i) const { return function(left[i], right[i]); }
+    };
+    using linear_evaluator = evaluator<typename Left::linear_evaluator, typename Right::linear_evaluator>;
+    using row_evaluator    = evaluator<typename Left::row_evaluator,    typename Right::row_evaluator>;
+
+    binary_expression(const Function& function, const Left& left, const Right& right)
+    : _function(function)
+    , _left    (left)
+    , _right   (right)
+    , _lengths  (internal::expressionLengths(_left, _right))
+    , _broadcast(internal::isBroadcast(_left, _lengths) || internal::isBroadcast(_right, _lengths))
+    {}
+
+    static constexpr std::size_t dimensions() noexcept { return std::tuple_size<lengths_type>::value; }
+
+    const lengths_type& lengths() const noexcept { return _lengths; }
+
+    template <typename Strides>
+    bool isLinear(const Strides& denseStrides) const noexcept
+    {
+        // the elements of a broadcast operand are repeated, i.e. they aren't in memory order
+        return !_broadcast && _left.isLinear(denseStrides) && _right.isLinear(denseStrides);
+    }
+
+    linear_evaluator linear() const { return {_function, _left.linear(), _right.linear()}; }
+
+    template <typename Indices>
+    row_evaluator row(const Indices& indices, const std::size_t dim) const
+    {
+        return {_function, _left.row(indices, dim), _right.row(indices, dim)};
+    }
+
+private:
+
+    Function     _function;
+    Left         _left;
+    Right        _right;
+    lengths_type _lengths;
+    bool         _broadcast;  ///< whether one of the operands is broadcast
+};
+
+namespace internal
+{
+
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+struct is_expression_operand<array<ValueType, Dimensions, Order, Allocator>> : std::true_type {};
+
+template <typename ValueType, std::size_t Dimensions, array_order Order>
+struct is_expression_operand<array_view<ValueType, Dimensions, Order>> : std::true_type {};
+
+/// converts the operands of the element-wise operations into expression nodes
+/// (expressions are used as-is)
+template <typename T, typename = void>
+struct expression_operand
+{
+    using type = T;
+    static const type& make(const T& operand) noexcept { return operand; }
+};
+
+template <typename T>
+struct expression_operand<T, enable_if_t<std::is_arithmetic<T>::value, void>>
+{
+    using type = scalar_expression<T>;
+    static type make(const T& operand) { return type{operand}; }
+};
+
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+struct expression_operand<array<ValueType, Dimensions, Order, Allocator>, void>
+{
+    using type = terminal_expression<ValueType, Dimensions, Order>;
+    static type make(const array<ValueType, Dimensions, Order, Allocator>& operand) noexcept { return type{operand.view()}; }
+};
+
+template <typename ValueType, std::size_t Dimensions, array_order Order>
+struct expression_operand<array_view<ValueType, Dimensions, Order>, void>
+{
+    using type = terminal_expression<typename std::remove_const<ValueType>::type, Dimensions, Order>;
+    static type make(const array_view<ValueType, Dimensions, Order>& operand) noexcept { return type{operand}; }
+};
+
+template <typename T>
+using expression_operand_t = typename expression_operand<T>::type;
+
+template <typename Function, typename Operand>
+unary_expression<Function, expression_operand_t<Operand>>
+makeExpression(const Function& function, const Operand& operand)
+{
+    return {function, expression_operand<Operand>::make(operand)};
+}
+
+template <typename Function, typename Left, typename Right>
+binary_expression<Function, expression_operand_t<Left>, expression_operand_t<Right>>
+makeExpression(const Function& function, const Left& left, const Right& right)
+{
+    return {function, expression_operand<Left>::make(left), expression_operand<Right>::make(right)};
+}
+
+// the element-wise operations
+struct op_plus       { template <typename L, typename R> auto operator()(const L& l, const R& r) const -> decltype(l + r) { return l + r; } };
+struct op_minus      { template <typename L, typename R> auto operator()(const L& l, const R& r) const -> decltype(l - r) { return l - r; } };
+struct op_multiplies { template <typename L, typename R> auto operator()(const L& l, const R& r) const -> decltype(l * r) { return l * r; } };
+struct op_divides    { template <typename L, typename R> auto operator()(const L& l, const R& r) const -> decltype(l / r) { return l / r; } };
+struct op_negate     { template <typename T> auto operator()(const T& x) const -> decltype(-x)           { return -x;           } };
+struct op_abs        { template <typename T> auto operator()(const T& x) const -> decltype(std::abs(x))  { return std::abs(x);  } };
+struct op_sqrt       { template <typename T> auto operator()(const T& x) const -> decltype(std::sqrt(x)) { return std::sqrt(x); } };
+struct op_exp        { template <typename T> auto operator()(const T& x) const -> decltype(std::exp(x))  { return std::exp(x);  } };
+struct op_log        { template <typename T> auto operator()(const T& x) const -> decltype(std::log(x))  { return std::log(x);  } };
+struct op_sin        { template <typename T> auto operator()(const T& x) const -> decltype(std::sin(x))  { return std::sin(x);  } };
+struct op_cos        { template <typename T> auto operator()(const T& x) const -> decltype(std::cos(x))  { return std::cos(x);  } };
+
+}
+
+namespace internal
+{
+
+/// the SIMD kernel that implements an operation of the expressions, if any
+template <typename Function>
+struct simd_kernel : std::false_type {};
+
+template <>
+struct simd_kernel<op_plus> : std::true_type
+{
+    template <typename T>
+    static void apply(const T* a, const T* b, T* out, const std::size_t size) noexcept { ::hyper_array::simd::add(a, b, out, size); }
+};
+
+template <>
+struct simd_kernel<op_minus> : std::true_type
+{
+    template <typename T>
+    static void apply(const T* a, const T* b, T* out, const std::size_t size) noexcept { ::hyper_array::simd::sub(a, b, out, size); }
+};
+
+template <>
+struct simd_kernel<op_multiplies> : std::true_type
+{
+    template <typename T>
+    static void apply(const T* a, const T* b, T* out, const std::size_t size) noexcept { ::hyper_array::simd::mul(a, b, out, size); }
+};
+
+template <>
+struct simd_kernel<op_divides> : std::true_type
+{
+    template <typename T>
+    static void apply(const T* a, const T* b, T* out, const std::size_t size) noexcept { ::hyper_array::simd::div(a, b, out, size); }
+};
+
+template <typename T>
+struct is_simd_type : std::integral_constant<bool, std::is_same<T, float>::value || std::is_same<T, double>::value> {};
+
+/// evaluates an expression whose operands are all laid out like the destination
+template <typename Expression, typename ValueType>
+void evaluateLinear(const Expression& expression, ValueType* data, const std::size_t size)
+{
+    const auto src = expression.linear();
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        data[i] = static_cast<ValueType>(src[i]);
+    }
+}
+
+/// `a @ b` between arrays of `float`s or `double`s: uses the run-time dispatched SIMD kernels
+template <typename Function, typename T, std::size_t Dimensions, array_order LeftOrder, array_order RightOrder>
+enable_if_t<simd_kernel<Function>::value && is_simd_type<T>::value, void>
+evaluateLinear(const binary_expression<Function,
+                                       terminal_expression<T, Dimensions, LeftOrder>,
+                                       terminal_expression<T, Dimensions, RightOrder>>& expression,
+               T* data, const std::size_t size)
+{
+    const auto src = expression.linear();
+    simd_kernel<Function>::apply(src.left.data, src.right.data, data, size);
+}
+
+/// `abs(a)` over an array of `float`s or `double`s: uses the run-time dispatched SIMD kernels
+template <typename T, std::size_t Dimensions, array_order Order>
+enable_if_t<is_simd_type<T>::value, void>
+evaluateLinear(const unary_expression<op_abs, terminal_expression<T, Dimensions, Order>>& expression,
+               T* data, const std::size_t size)
+{
+    ::hyper_array::simd::abs(expression.linear().operand.data, data, size);
+}
+
+}
+
+/// Evaluates an element-wise expression into a view, in a single pass
+///
+/// When the view and all the operands are laid out densely in the same order,
+/// the elements are computed in a single flat loop (that the compiler can vectorize),
+/// or using the hyper_array::simd kernels for the simplest expressions (e.g. `a + b`).
+/// Otherwise, they are computed row by row, along the view's smallest stride.
+///
+/// @note element (i, j, ...) of `dst` is computed from elements (i, j, ...) of the operands only:
+///       `dst` can be one of the operands (e.g. `a = a * 2 + b`) but must not overlap them otherwise
+///       (e.g. `a = a.transpose() + b` is wrong)
+/// @note `dst` isn't broadcast: e.g. `col += a` is rejected when `col` is {3, 1} and `a` is {3, 4}
+/// @throw std::invalid_argument if `dst` doesn't have the same lengths as the expression
+template <typename Expression, typename ValueType, std::size_t Dimensions, array_order Order>
+internal::enable_if_t<internal::is_expression<Expression>::value, void>
+evaluate(const Expression& expression, const array_view<ValueType, Dimensions, Order>& dst)
+{
+    static_assert(Expression::dimensions() == Dimensions, "the expression and the view must have the same number of dimensions");
+    static_assert(!std::is_const<ValueType>::value, "cannot evaluate an expression into a read-only view");
+
+    if (!internal::equalLengths(expression.lengths(), dst.lengths()))
+    {
+        throw std::invalid_argument("hyper_array::evaluate: the destination's lengths differ from the expression's");
+    }
+
+    if (dst.size() == 0)
+    {
+        return;
+    }
+
+    ValueType* const data = dst.data();
+
+    const ::std::array<std::ptrdiff_t, Dimensions> denseStrides =
+        internal::toStrides(internal::computeIndexCoeffs<std::size_t, Dimensions, Order>(dst.lengths()));
+    if ((dst.coeffs() == denseStrides) && expression.isLinear(denseStrides))
+    {
+        internal::evaluateLinear(expression, data, dst.size());
+        return;
+    }
+
+    const std::size_t    dim    = internal::innermostDimension(dst.lengths(), dst.coeffs());
+    const std::size_t    length = dst.length(dim);
+    const std::ptrdiff_t stride = dst.coeff(dim);
+    const std::size_t    rows   = dst.size() / length;
+    ::std::array<std::size_t, Dimensions> indices{};
+    for (std::size_t row = 0; row < rows; ++row)
+    {
+        const auto       src = expression.row(indices, dim);
+        ValueType* const out = data + internal::stridedOffset(dst.coeffs(), indices);
+        for (std::size_t k = 0; k < length; ++k)
+        {
+            out[static_cast<std::ptrdiff_t>(k) * stride] = static_cast<ValueType>(src[k]);
+        }
+        internal::nextRow<Order>(indices, dst.lengths(), dim);
+    }
+}
+
+/// Element-wise sum of hyper arrays, views, expressions and/or scalars (lazily evaluated)
+///
+/// Usage:
+/// @code
+///     hyper_array::array<double, 2> a{3, 4}, b{3, 4}, c{3, 4};
+///     hyper_array::array<double, 2> d = a + b * c - 1.0;  // single loop, no temporaries
+///     d -= 2.0 * hyper_array::sqrt(c);                    // same for compound assignments
+/// @endcode
+template <typename Left, typename Right>
+internal::enable_if_t<
+    internal::are_expression_operands<Left, Right>::value,
+    binary_expression<internal::op_plus, internal::expression_operand_t<Left>, internal::expression_operand_t<Right>>>
+operator+(const Left& left, const Right& right)
+{
+    return internal::makeExpression(internal::op_plus{}, left, right);
+}
+
+/// Element-wise difference, @see operator+()
+template <typename Left, typename Right>
+internal::enable_if_t<
+    internal::are_expression_operands<Left, Right>::value,
+    binary_expression<internal::op_minus, internal::expression_operand_t<Left>, internal::expression_operand_t<Right>>>
+operator-(const Left& left, const Right& right)
+{
+    return internal::makeExpression(internal::op_minus{}, left, right);
+}
+
+/// Element-wise product, @see operator+()
+template <typename Left, typename Right>
+internal::enable_if_t<
+    internal::are_expression_operands<Left, Right>::value,
+    binary_expression<internal::op_multiplies, internal::expression_operand_t<Left>, internal::expression_operand_t<Right>>>
+operator*(const Left& left, const Right& right)
+{
+    return internal::makeExpression(internal::op_multiplies{}, left, right);
+}
+
+/// Element-wise quotient, @see operator+()
+template <typename Left, typename Right>
+internal::enable_if_t<
+    internal::are_expression_operands<Left, Right>::value,
+    binary_expression<internal::op_divides, internal::expression_operand_t<Left>, internal::expression_operand_t<Right>>>
+operator/(const Left& left, const Right& right)
+{
+    return internal::makeExpression(internal::op_divides{}, left, right);
+}
+
+/// Element-wise negation, @see operator+()
+template <typename Operand>
+internal::enable_if_t<
+    internal::is_expression_operand<Operand>::value,
+    unary_expression<internal::op_negate, internal::expression_operand_t<Operand>>>
+operator-(const Operand& operand)
+{
+    return internal::makeExpression(internal::op_negate{}, operand);
+}
+
+/// Element-wise `std::abs()`, @see operator+()
+template <typename Operand>
+internal::enable_if_t<
+    internal::is_expression_operand<Operand>::value,
+    unary_expression<internal::op_abs, internal::expression_operand_t<Operand>>>
+abs(const Operand& operand)
+{
+    return internal::makeExpression(internal::op_abs{}, operand);
+}
+
+/// Element-wise `std::sqrt()`, @see operator+()
+template <typename Operand>
+internal::enable_if_t<
+    internal::is_expression_operand<Operand>::value,
+    unary_expression<internal::op_sqrt, internal::expression_operand_t<Operand>>>
+sqrt(const Operand& operand)
+{
+    return internal::makeExpression(internal::op_sqrt{}, operand);
+}
+
+/// Element-wise `std::exp()`, @see operator+()
+template <typename Operand>
+internal::enable_if_t<
+    internal::is_expression_operand<Operand>::value,
+    unary_expression<internal::op_exp, internal::expression_operand_t<Operand>>>
+exp(const Operand& operand)
+{
+    return internal::makeExpression(internal::op_exp{}, operand);
+}
+
+/// Element-wise `std::log()`, @see operator+()
+template <typename Operand>
+internal::enable_if_t<
+    internal::is_expression_operand<Operand>::value,
+    unary_expression<internal::op_log, internal::expression_operand_t<Operand>>>
+log(const Operand& operand)
+{
+    return internal::makeExpression(internal::op_log{}, operand);
+}
+
+/// Element-wise `std::sin()`, @see operator+()
+template <typename Operand>
+internal::enable_if_t<
+    internal::is_expression_operand<Operand>::value,
+    unary_expression<internal::op_sin, internal::expression_operand_t<Operand>>>
+sin(const Operand& operand)
+{
+    return internal::makeExpression(internal::op_sin{}, operand);
+}
+
+/// Element-wise `std::cos()`, @see operator+()
+template <typename Operand>
+internal::enable_if_t<
+    internal::is_expression_operand<Operand>::value,
+    unary_expression<internal::op_cos, internal::expression_operand_t<Operand>>>
+cos(const Operand& operand)
+{
+    return internal::makeExpression(internal::op_cos{}, operand);
+}
+
+/// Applies a user-defined function element-wise (lazily evaluated)
+///
+/// Usage:
+/// @code
+///     hyper_array::array<float, 2> clamped = hyper_array::elementwise([](float x) { return x < 0.f ? 0.f : x; }, a - b);
+/// @endcode
+template <typename Function, typename Operand>
+internal::enable_if_t<
+    internal::is_expression_operand<Operand>::value,
+    unary_expression<Function, internal::expression_operand_t<Operand>>>
+elementwise(const Function& function, const Operand& operand)
+{
+    return internal::makeExpression(function, operand);
+}
+
+/// Applies a user-defined binary function element-wise (lazily evaluated)
+/// e.g. `hyper_array::elementwise([](double x, double y) { return std::atan2(y, x); }, a, b)`
+template <typename Function, typename Left, typename Right>
+internal::enable_if_t<
+    internal::are_expression_operands<Left, Right>::value,
+    binary_expression<Function, internal::expression_operand_t<Left>, internal::expression_operand_t<Right>>>
+elementwise(const Function& function, const Left& left, const Right& right)
+{
+    return internal::makeExpression(function, left, right);
+}
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Reductions">
+namespace internal
+{
+
+struct op_min { template <typename T> T operator()(const T& a, const T& b) const { return (b < a) ? b : a; } };
+struct op_max { template <typename T> T operator()(const T& a, const T& b) const { return (a < b) ? b : a; } };
+
+/// number of independent accumulators used when reducing contiguous elements
+/// (i.e. enough to fill an AVX-512 register)
+template <typename ValueType>
+constexpr std::size_t reductionLanes() noexcept
+{
+    return (64 / sizeof(ValueType) < 1)  ? 1
+         : (64 / sizeof(ValueType) > 16) ? 16
+         : 64 / sizeof(ValueType);
+}
+
+/// number of accumulators that are updated together when reducing non-contiguous elements
+/// (i.e. 8 KiB, so that they stay in the L1 cache)
+template <typename ValueType>
+constexpr std::size_t reductionTile() noexcept
+{
+    return (8192 / sizeof(ValueType) < 1) ? 1 : 8192 / sizeof(ValueType);
+}
+
+/// reduces `length` contiguous elements
+///
+/// The elements are accumulated in several independent "lanes" that are combined at the end:
+/// unlike a single accumulator, this allows the compiler to vectorize the loop, even for floating point types.
+/// @note this changes the order of the operations, i.e. `function` must be associative and commutative
+template <typename ValueType, typename Function>
+ValueType reduceContiguous(const ValueType* data, const std::size_t length,
+                           const Function& function, const ValueType& identity)
+{
+    constexpr std::size_t lanes = reductionLanes<ValueType>();
+
+    ValueType accumulators[lanes];
+    for (ValueType& accumulator : accumulators)
+    {
+        accumulator = identity;
+    }
+
+    std::size_t i = 0;
+    for (; i + lanes <= length; i += lanes)
+    {
+        for (std::size_t lane = 0; lane < lanes; ++lane)
+        {
+            accumulators[lane] = static_cast<ValueType>(function(accumulators[lane], data[i + lane]));
+        }
+    }
+    for (; i < length; ++i)
+    {
+        accumulators[0] = static_cast<ValueType>(function(accumulators[0], data[i]));
+    }
+
+    for (std::size_t width = lanes / 2; width > 0; width /= 2)
+    {
+        for (std::size_t lane = 0; lane < width; ++lane)
+        {
+            accumulators[lane] = static_cast<ValueType>(function(accumulators[lane], accumulators[lane + width]));
+        }
+    }
+    return accumulators[0];
+}
+
+/// reduces the "middle" dimension of a dense `outer x length x inner` data array into `outer x inner` elements
+///
+/// The traversal always streams contiguous memory:
+/// - if the reduced dimension is contiguous (`inner == 1`), each output element is a reduceContiguous()
+/// - otherwise, the rows of the reduced dimension are accumulated element-wise into a tile of outputs
+///   that stays in the L1 cache
+template <typename ValueType, typename Function>
+void reduceAxis(const ValueType* data, const std::size_t length, const std::size_t inner, const std::size_t outer,
+                ValueType* out, const Function& function, const ValueType& identity)
+{
+    for (std::size_t o = 0; o < outer; ++o)
+    {
+        const ValueType* block  = data + o * length * inner;
+        ValueType*       result = out  + o * inner;
+
+        if (inner == 1)
+        {
+            *result = reduceContiguous(block, length, function, identity);
+            continue;
+        }
+
+        constexpr std::size_t tile = reductionTile<ValueType>();
+        for (std::size_t first = 0; first < inner; first += tile)
+        {
+            const std::size_t count = (inner - first < tile) ? (inner - first) : tile;
+            ValueType* const  acc   = result + first;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                acc[i] = identity;
+            }
+            for (std::size_t k = 0; k < length; ++k)
+            {
+                const ValueType* row = block + k * inner + first;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    acc[i] = static_cast<ValueType>(function(acc[i], row[i]));
+                }
+            }
+        }
+    }
+}
+
+/// the lengths of an array without its `axis`-th dimension
+template <typename size_type, std::size_t Dimensions>
+::std::array<size_type, Dimensions - 1> reducedLengths(const ::std::array<size_type, Dimensions>& lengths,
+                                                       const std::size_t axis)
+{
+    ::std::array<size_type, Dimensions - 1> result{};
+    for (std::size_t dim = 0, k = 0; dim < Dimensions; ++dim)
+    {
+        if (dim != axis)
+        {
+            result[k++] = lengths[dim];
+        }
+    }
+    return result;
+}
+
+/// the identity element of op_min/op_max
+template <typename ValueType>
+constexpr ValueType largestValue() noexcept
+{
+    return std::numeric_limits<ValueType>::has_infinity ? std::numeric_limits<ValueType>::infinity()
+                                                        : std::numeric_limits<ValueType>::max();
+}
+
+template <typename ValueType>
+constexpr ValueType lowestValue() noexcept
+{
+    return std::numeric_limits<ValueType>::has_infinity ? -std::numeric_limits<ValueType>::infinity()
+                                                        : std::numeric_limits<ValueType>::lowest();
+}
+
+}
+
+/// Reduces a hyper array along one of its dimensions
+///
+/// Usage:
+/// @code
+///     hyper_array::array<double, 3> arr{10, 20, 30};
+///     hyper_array::array<double, 2> res = hyper_array::reduce(arr, 1, std::plus<double>(), 0.0);  // res.lengths() == {10, 30}
+///     // res(i, k) == arr(i, 0, k) + arr(i, 1, k) + ... + arr(i, 19, k)
+/// @endcode
+///
+/// Whatever the reduced dimension, the data are traversed in memory order
+/// (cf. internal::reduceAxis()), which keeps the inner loops contiguous and vectorizable.
+///
+/// @note `function` must be associative and commutative, and `identity` must be its identity element
+///       (the order in which the elements are combined is unspecified)
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator, typename Function>
+array<ValueType, Dimensions - 1, Order>
+reduce(const array<ValueType, Dimensions, Order, Allocator>& arr,
+       const std::size_t axis,         ///< the dimension to reduce
+       const Function&   function,     ///< `ValueType(ValueType, ValueType)`
+       const ValueType&  identity)     ///< the result of reducing 0 elements
+{
+    static_assert(Dimensions > 1, "reducing a 1D array along an axis would result in a 0D array");
+    assert(axis < Dimensions);
+
+    // in memory: [outer][arr.length(axis)][inner], whatever the order
+    array<ValueType, Dimensions - 1, Order> result{uninitialized, internal::reducedLengths(arr.lengths(), axis)};
+    const std::size_t inner = arr.coeff(axis);
+    const std::size_t outer = (inner == 0) ? 0 : result.size() / inner;
+    internal::reduceAxis(arr.data(), arr.length(axis), inner, outer, result.data(), function, identity);
+
+    return result;
+}
+
+/// Sum of the elements along a dimension, @see reduce()
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+array<ValueType, Dimensions - 1, Order>
+sum(const array<ValueType, Dimensions, Order, Allocator>& arr, const std::size_t axis)
+{
+    return reduce(arr, axis, internal::op_plus{}, ValueType(0));
+}
+
+/// Product of the elements along a dimension, @see reduce()
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+array<ValueType, Dimensions - 1, Order>
+prod(const array<ValueType, Dimensions, Order, Allocator>& arr, const std::size_t axis)
+{
+    return reduce(arr, axis, internal::op_multiplies{}, ValueType(1));
+}
+
+/// Minimum of the elements along a dimension, @see reduce()
+/// @note the reduced dimension must not be empty
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+array<ValueType, Dimensions - 1, Order>
+min(const array<ValueType, Dimensions, Order, Allocator>& arr, const std::size_t axis)
+{
+    assert(arr.length(axis) > 0);
+    return reduce(arr, axis, internal::op_min{}, internal::largestValue<ValueType>());
+}
+
+/// Maximum of the elements along a dimension, @see reduce()
+/// @note the reduced dimension must not be empty
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+array<ValueType, Dimensions - 1, Order>
+max(const array<ValueType, Dimensions, Order, Allocator>& arr, const std::size_t axis)
+{
+    assert(arr.length(axis) > 0);
+    return reduce(arr, axis, internal::op_max{}, internal::lowestValue<ValueType>());
+}
+
+/// Arithmetic mean of the elements along a dimension, @see reduce()
+/// @note for integral types, the result is rounded towards zero (i.e. `sum / length`)
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+array<ValueType, Dimensions - 1, Order>
+mean(const array<ValueType, Dimensions, Order, Allocator>& arr, const std::size_t axis)
+{
+    assert(arr.length(axis) > 0);
+    array<ValueType, Dimensions - 1, Order> result = sum(arr, axis);
+    result /= static_cast<ValueType>(arr.length(axis));
+    return result;
+}
+
+/// Reduces all the elements of a hyper array
+/// e.g. `double total = hyper_array::reduce(arr, std::plus<double>(), 0.0);`
+/// @note `function` must be associative and commutative, and `identity` must be its identity element
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator, typename Function>
+ValueType reduce(const array<ValueType, Dimensions, Order, Allocator>& arr, const Function& function, const ValueType& identity)
+{
+    return internal::reduceContiguous(arr.data(), arr.size(), function, identity);
+}
+
+/// Sum of all the elements, @see reduce()
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+ValueType sum(const array<ValueType, Dimensions, Order, Allocator>& arr)
+{
+    return reduce(arr, internal::op_plus{}, ValueType(0));
+}
+
+/// Product of all the elements, @see reduce()
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+ValueType prod(const array<ValueType, Dimensions, Order, Allocator>& arr)
+{
+    return reduce(arr, internal::op_multiplies{}, ValueType(1));
+}
+
+/// Minimum of all the elements, @see reduce()
+/// @note the array must not be empty
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+ValueType min(const array<ValueType, Dimensions, Order, Allocator>& arr)
+{
+    assert(arr.size() > 0);
+    return reduce(arr, internal::op_min{}, internal::largestValue<ValueType>());
+}
+
+/// Maximum of all the elements, @see reduce()
+/// @note the array must not be empty
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+ValueType max(const array<ValueType, Dimensions, Order, Allocator>& arr)
+{
+    assert(arr.size() > 0);
+    return reduce(arr, internal::op_max{}, internal::lowestValue<ValueType>());
+}
+
+/// Arithmetic mean of all the elements, @see reduce()
+/// @note the array must not be empty
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+ValueType mean(const array<ValueType, Dimensions, Order, Allocator>& arr)
+{
+    assert(arr.size() > 0);
+    return static_cast<ValueType>(sum(arr) / static_cast<ValueType>(arr.size()));
+}
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Parallelism">
+namespace internal
+{
+
+/// the worker index of the calling thread, if it is currently running a task of a hyper_array::thread_pool
+/// (`nullptr` otherwise)
+inline const std::size_t*& currentPoolWorker() noexcept
+{
+    static thread_local const std::size_t* worker = nullptr;
+    return worker;
+}
+
+/// an object that is alone in its cache line(s), i.e. that can be updated by a thread without "false sharing"
+template <typename ValueType>
+struct cache_padded
+{
+    alignas(cache_line_alignment) ValueType value;
+};
+
+/// the indices `[begin, end)` of the tasks that a thread_pool's worker has yet to run
+struct steal_range
+{
+    std::mutex  mutex;
+    std::size_t begin = 0;
+    std::size_t end   = 0;
+};
+
+}
+
+/// A fixed-size pool of threads that run "parallel for" loops, with work stealing
+///
+/// The thread that calls run() or parallel_for() takes part in the loop, i.e. a pool of `n` threads
+/// only starts `n - 1` threads.
+///
+/// Each thread starts with a contiguous share of the loop's indices, which it runs in increasing order.
+/// A thread that runs out of indices steals the upper half of the remaining indices of another thread,
+/// so that uneven tasks are balanced while the threads keep working on contiguous indices.
+///
+/// Usage:
+/// @code
+///     hyper_array::thread_pool pool{4};
+///     pool.parallel_for(1000, [&](std::size_t i) { process(i); });
+/// @endcode
+///
+/// @note the tasks must not throw
+/// @note loops that are started from inside a task run serially, in the calling thread
+class thread_pool
+{
+public:
+
+    /// @param threadCount  total number of threads that run the loops, including the calling thread
+    explicit thread_pool(const std::size_t threadCount = defaultThreadCount())
+    {
+        const std::size_t workerCount = (threadCount > 1) ? (threadCount - 1) : 0;
+        _ranges = ranges_type(workerCount + 1);
+        _workers.reserve(workerCount);
+        for (std::size_t w = 1; w <= workerCount; ++w)
+        {
+            _workers.emplace_back(&thread_pool::workerLoop, this, w);
+        }
+    }
+
+    thread_pool(const thread_pool&)            = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{_mutex};
+            _stop = true;
+        }
+        _wake.notify_all();
+        for (std::thread& worker : _workers)
+        {
+            worker.join();
+        }
+    }
+
+    /// number of threads that run the loops, including the calling thread
+    std::size_t size() const noexcept
+    {
+        return _workers.size() + 1;
+    }
+
+    /// Calls `task(index, worker)` for every `index` in `[0, count)`, then returns
+    ///
+    /// `worker` identifies the thread that runs the task, it is in `[0, size())`,
+    /// e.g. for accumulating per-thread results.
+    /// The indices are distributed dynamically (cf. thread_pool), i.e. in no particular order.
+    template <typename Task>
+    void run(const std::size_t count, const Task& task)
+    {
+        if ((count <= 1) || _workers.empty() || (internal::currentPoolWorker() != nullptr))
+        {
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                task(index, std::size_t{0});
+            }
+            return;
+        }
+
+        const std::function<void(std::size_t, std::size_t)> function{std::cref(task)};
+
+        const std::lock_guard<std::mutex> runLock{_runMutex};  // one loop at a time
+        {
+            const std::lock_guard<std::mutex> lock{_mutex};
+            const std::size_t threads = size();
+            for (std::size_t worker = 0; worker < threads; ++worker)
+            {
+                internal::steal_range& range = _ranges[worker].value;
+                const std::lock_guard<std::mutex> rangeLock{range.mutex};
+                range.begin = share(count, threads, worker);
+                range.end   = share(count, threads, worker + 1);
+            }
+            _task = &function;
+            _busy = _workers.size();
+            ++_generation;
+        }
+        _wake.notify_all();
+
+        work(0);
+
+        std::unique_lock<std::mutex> lock{_mutex};
+        _done.wait(lock, [this] { return _busy == 0; });
+        _task = nullptr;
+    }
+
+    /// Calls `task(index)` for every `index` in `[0, count)`, then returns
+    /// @see run()
+    template <typename Task>
+    void parallel_for(const std::size_t count, const Task& task)
+    {
+        run(count, [&task](const std::size_t index, const std::size_t) { task(index); });
+    }
+
+private:
+
+    static std::size_t defaultThreadCount() noexcept
+    {
+        const unsigned count = std::thread::hardware_concurrency();
+        return (count == 0) ? 1 : count;
+    }
+
+    /// the first index of the `worker`-th share of `[0, count)`
+    static std::size_t share(const std::size_t count, const std::size_t threads, const std::size_t worker) noexcept
+    {
+        return worker * (count / threads) + ((worker < count % threads) ? worker : count % threads);
+    }
+
+    /// takes the next index of `worker`'s own range
+    bool claim(const std::size_t worker, std::size_t& index)
+    {
+        internal::steal_range& range = _ranges[worker].value;
+        const std::lock_guard<std::mutex> lock{range.mutex};
+        if (range.begin == range.end)
+        {
+            return false;
+        }
+        index = range.begin++;
+        return true;
+    }
+
+    /// moves the upper half of another worker's range to `worker`'s range, and takes its first index
+    bool steal(const std::size_t worker, std::size_t& index)
+    {
+        const std::size_t threads = size();
+        for (std::size_t offset = 1; offset < threads; ++offset)
+        {
+            std::size_t first = 0;
+            std::size_t last  = 0;
+            {
+                internal::steal_range& victim = _ranges[(worker + offset) % threads].value;
+                const std::lock_guard<std::mutex> lock{victim.mutex};
+                if (victim.begin == victim.end)
+                {
+                    continue;
+                }
+                last       = victim.end;
+                first      = victim.end - (victim.end - victim.begin + 1) / 2;
+                victim.end = first;
+            }
+
+            internal::steal_range& range = _ranges[worker].value;
+            const std::lock_guard<std::mutex> lock{range.mutex};
+            range.begin = first + 1;
+            range.end   = last;
+            index       = first;
+            return true;
+        }
+        return false;
+    }
+
+    /// runs the tasks of the current loop until there are none left
+    void work(const std::size_t worker)
+    {
+        const std::size_t* const previous = internal::currentPoolWorker();
+        internal::currentPoolWorker() = &worker;
+
+        std::size_t index = 0;
+        while (claim(worker, index) || steal(worker, index))
+        {
+            (*_task)(index, worker);
+        }
+
+        internal::currentPoolWorker() = previous;
+    }
+
+    void workerLoop(const std::size_t worker)
+    {
+        std::size_t generation = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock{_mutex};
+                _wake.wait(lock, [&] { return _stop || (_generation != generation); });
+                if (_stop)
+                {
+                    return;
+                }
+                generation = _generation;
+            }
+
+            work(worker);
+
+            {
+                const std::lock_guard<std::mutex> lock{_mutex};
+                if (--_busy == 0)
+                {
+                    _done.notify_one();
+                }
+            }
+        }
+    }
+
+    using ranges_type = std::vector<internal::cache_padded<internal::steal_range>,
+                                    aligned_allocator<internal::cache_padded<internal::steal_range>>>;
+
+    ranges_type              _ranges;           ///< the remaining tasks of each thread (the caller's is `_ranges[0]`)
+    std::vector<std::thread> _workers;
+    std::mutex               _runMutex;         ///< serializes the calls to run()
+    std::mutex               _mutex;            ///< protects the members below
+    std::condition_variable  _wake;             ///< signals a new loop (or the destruction of the pool)
+    std::condition_variable  _done;             ///< signals the end of a loop
+    const std::function<void(std::size_t, std::size_t)>* _task = nullptr;  ///< the current loop's task
+    std::size_t              _busy       = 0;   ///< number of workers that haven't finished the current loop
+    std::size_t              _generation = 0;   ///< incremented at each loop
+    bool                     _stop       = false;
+};
+
+/// the pool used by default by the parallel algorithms (`std::thread::hardware_concurrency()` threads)
+inline thread_pool& default_thread_pool()
+{
+    static thread_pool pool;
+    return pool;
+}
+
+/// Selects the parallel version of an algorithm (cf. `std::execution::par`), and configures it
+///
+/// Usage:
+/// @code
+///     double total = hyper_array::sum(hyper_array::par, arr);                         // default_thread_pool()
+///     double exact = hyper_array::sum(hyper_array::par.on(pool).deterministic(), arr); // reproducible
+/// @endcode
+class parallel_policy
+{
+public:
+
+    constexpr parallel_policy() noexcept
+    : _pool         (nullptr)
+    , _deterministic(false)
+    {}
+
+    /// runs the algorithm on `pool` instead of default_thread_pool()
+    parallel_policy on(thread_pool& pool) const noexcept
+    {
+        parallel_policy policy{*this};
+        policy._pool = &pool;
+        return policy;
+    }
+
+    /// Makes the results bitwise reproducible, whatever the number of threads
+    /// i.e. floating point values are always combined in the same order
+    parallel_policy deterministic(const bool enabled = true) const noexcept
+    {
+        parallel_policy policy{*this};
+        policy._deterministic = enabled;
+        return policy;
+    }
+
+    thread_pool& pool() const
+    {
+        return (_pool != nullptr) ? *_pool : default_thread_pool();
+    }
+
+    bool is_deterministic() const noexcept
+    {
+        return _deterministic;
+    }
+
+private:
+
+    thread_pool* _pool;
+    bool         _deterministic;
+};
+
+/// @see parallel_policy
+constexpr parallel_policy par{};
+
+namespace internal
+{
+
+/// number of elements per task of the parallel algorithms
+/// (the partitioning must not depend on the number of threads, cf. parallel_policy::deterministic())
+template <typename ValueType>
+constexpr std::size_t parallelGrain() noexcept
+{
+    return (std::size_t{1} << 19) / sizeof(ValueType);  // 512 KiB
+}
+
+/// reduces `size` contiguous elements in parallel
+///
+/// The data are split into chunks of parallelGrain() elements.
+/// - by default, each thread accumulates the chunks it runs into its own (cache-padded) accumulator,
+///   then the accumulators are combined
+/// - if `deterministic`, each chunk is reduced separately, then the results are combined in order
+template <typename ValueType, typename Function>
+ValueType parallelReduce(thread_pool& pool, const bool deterministic,
+                         const ValueType* data, const std::size_t size,
+                         const Function& function, const ValueType& identity)
+{
+    constexpr std::size_t grain  = parallelGrain<ValueType>();
+    const std::size_t     chunks = (size + grain - 1) / grain;
+    if (chunks <= 1)
+    {
+        return reduceContiguous(data, size, function, identity);
+    }
+
+    const auto reduceChunk = [&](const std::size_t chunk) {
+        const std::size_t first = chunk * grain;
+        return reduceContiguous(data + first, (size - first < grain) ? (size - first) : grain, function, identity);
+    };
+
+    if (deterministic)
+    {
+        std::vector<ValueType> partials(chunks, identity);
+        pool.parallel_for(chunks, [&](const std::size_t chunk) {
+            partials[chunk] = reduceChunk(chunk);
+        });
+        return reduceContiguous(partials.data(), chunks, function, identity);
+    }
+
+    std::vector<cache_padded<ValueType>, aligned_allocator<cache_padded<ValueType>>> accumulators(pool.size());
+    std::vector<ValueType> results(pool.size(), identity);
+    for (cache_padded<ValueType>& accumulator : accumulators)
+    {
+        accumulator.value = identity;
+    }
+    pool.run(chunks, [&](const std::size_t chunk, const std::size_t worker) {
+        accumulators[worker].value = static_cast<ValueType>(function(accumulators[worker].value, reduceChunk(chunk)));
+    });
+    for (std::size_t worker = 0; worker < accumulators.size(); ++worker)
+    {
+        results[worker] = accumulators[worker].value;
+    }
+    return reduceContiguous(results.data(), results.size(), function, identity);
+}
+
+/// parallel version of reduceAxis()
+///
+/// - if there are enough output elements, the threads compute separate (tiles of) outputs,
+///   i.e. the results are the same as reduceAxis()'s
+/// - otherwise, the reduced dimension is split into segments whose partial results are combined in order
+///
+/// Either way, the partitioning only depends on the array's lengths, i.e. the results are deterministic.
+template <typename ValueType, typename Function>
+void parallelReduceAxis(thread_pool& pool,
+                        const ValueType* data, const std::size_t length, const std::size_t inner, const std::size_t outer,
+                        ValueType* out, const Function& function, const ValueType& identity)
+{
+    constexpr std::size_t grain    = parallelGrain<ValueType>();
+    constexpr std::size_t tile     = reductionTile<ValueType>();
+    constexpr std::size_t minTasks = 64;
+
+    const std::size_t outputs = outer * inner;
+    if ((outputs == 0) || (outputs * length <= grain))
+    {
+        reduceAxis(data, length, inner, outer, out, function, identity);
+        return;
+    }
+
+    const std::size_t tiles = (inner + tile - 1) / tile;
+    if (outer * tiles >= minTasks)
+    {
+        pool.parallel_for(outer * tiles, [&](const std::size_t task) {
+            const std::size_t o = task / tiles;
+            if (inner == 1)
+            {
+                out[o] = reduceContiguous(data + o * length, length, function, identity);
+                return;
+            }
+
+            // same computations as reduceAxis()'s, for a single tile
+            const std::size_t first = (task % tiles) * tile;
+            const std::size_t count = (inner - first < tile) ? (inner - first) : tile;
+            ValueType* const  acc   = out + o * inner + first;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                acc[i] = identity;
+            }
+            for (std::size_t k = 0; k < length; ++k)
+            {
+                const ValueType* row = data + (o * length + k) * inner + first;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    acc[i] = static_cast<ValueType>(function(acc[i], row[i]));
+                }
+            }
+        });
+        return;
+    }
+
+    const std::size_t segmentLength = (grain / inner > 0) ? (grain / inner) : 1;
+    const std::size_t segments      = (length + segmentLength - 1) / segmentLength;
+    std::vector<ValueType> partials(segments * outputs);
+    pool.parallel_for(outer * segments, [&](const std::size_t task) {
+        const std::size_t o        = task / segments;
+        const std::size_t segment  = task % segments;
+        const std::size_t first    = segment * segmentLength;
+        const std::size_t count    = (length - first < segmentLength) ? (length - first) : segmentLength;
+        reduceAxis(data + (o * length + first) * inner, count, inner, 1,
+                   partials.data() + segment * outputs + o * inner, function, identity);
+    });
+    for (std::size_t i = 0; i < outputs; ++i)
+    {
+        ValueType acc = partials[i];
+        for (std::size_t segment = 1; segment < segments; ++segment)
+        {
+            acc = static_cast<ValueType>(function(acc, partials[segment * outputs + i]));
+        }
+        out[i] = acc;
+    }
+}
+
+}
+
+/// Parallel version of reduce(arr, function, identity)
+/// @see parallel_policy
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator, typename Function>
+ValueType reduce(const parallel_policy& policy, const array<ValueType, Dimensions, Order, Allocator>& arr,
+                 const Function& function, const ValueType& identity)
+{
+    return internal::parallelReduce(policy.pool(), policy.is_deterministic(), arr.data(), arr.size(), function, identity);
+}
+
+/// Parallel version of reduce(arr, axis, function, identity)
+/// @note the results don't depend on the number of threads, whatever parallel_policy::is_deterministic()
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator, typename Function>
+array<ValueType, Dimensions - 1, Order>
+reduce(const parallel_policy& policy, const array<ValueType, Dimensions, Order, Allocator>& arr,
+       const std::size_t axis, const Function& function, const ValueType& identity)
+{
+    static_assert(Dimensions > 1, "reducing a 1D array along an axis would result in a 0D array");
+    assert(axis < Dimensions);
+
+    array<ValueType, Dimensions - 1, Order> result{uninitialized, internal::reducedLengths(arr.lengths(), axis)};
+    const std::size_t inner = arr.coeff(axis);
+    const std::size_t outer = (inner == 0) ? 0 : result.size() / inner;
+    internal::parallelReduceAxis(policy.pool(), arr.data(), arr.length(axis), inner, outer, result.data(), function, identity);
+
+    return result;
+}
+
+/// Parallel version of sum(arr)
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+ValueType sum(const parallel_policy& policy, const array<ValueType, Dimensions, Order, Allocator>& arr)
+{
+    return reduce(policy, arr, internal::op_plus{}, ValueType(0));
+}
+
+/// Parallel version of prod(arr)
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+ValueType prod(const parallel_policy& policy, const array<ValueType, Dimensions, Order, Allocator>& arr)
+{
+    return reduce(policy, arr, internal::op_multiplies{}, ValueType(1));
+}
+
+/// Parallel version of min(arr)
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+ValueType min(const parallel_policy& policy, const array<ValueType, Dimensions, Order, Allocator>& arr)
+{
+    assert(arr.size() > 0);
+    return reduce(policy, arr, internal::op_min{}, internal::largestValue<ValueType>());
+}
+
+/// Parallel version of max(arr)
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+ValueType max(const parallel_policy& policy, const array<ValueType, Dimensions, Order, Allocator>& arr)
+{
+    assert(arr.size() > 0);
+    return reduce(policy, arr, internal::op_max{}, internal::lowestValue<ValueType>());
+}
+
+/// Parallel version of mean(arr)
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+ValueType mean(const parallel_policy& policy, const array<ValueType, Dimensions, Order, Allocator>& arr)
+{
+    assert(arr.size() > 0);
+    return static_cast<ValueType>(sum(policy, arr) / static_cast<ValueType>(arr.size()));
+}
+
+/// Parallel version of sum(arr, axis)
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+array<ValueType, Dimensions - 1, Order>
+sum(const parallel_policy& policy, const array<ValueType, Dimensions, Order, Allocator>& arr, const std::size_t axis)
+{
+    return reduce(policy, arr, axis, internal::op_plus{}, ValueType(0));
+}
+
+/// Parallel version of prod(arr, axis)
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+array<ValueType, Dimensions - 1, Order>
+prod(const parallel_policy& policy, const array<ValueType, Dimensions, Order, Allocator>& arr, const std::size_t axis)
+{
+    return reduce(policy, arr, axis, internal::op_multiplies{}, ValueType(1));
+}
+
+/// Parallel version of min(arr, axis)
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+array<ValueType, Dimensions - 1, Order>
+min(const parallel_policy& policy, const array<ValueType, Dimensions, Order, Allocator>& arr, const std::size_t axis)
+{
+    assert(arr.length(axis) > 0);
+    return reduce(policy, arr, axis, internal::op_min{}, internal::largestValue<ValueType>());
+}
+
+/// Parallel version of max(arr, axis)
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+array<ValueType, Dimensions - 1, Order>
+max(const parallel_policy& policy, const array<ValueType, Dimensions, Order, Allocator>& arr, const std::size_t axis)
+{
+    assert(arr.length(axis) > 0);
+    return reduce(policy, arr, axis, internal::op_max{}, internal::lowestValue<ValueType>());
+}
+
+/// Parallel version of mean(arr, axis)
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+array<ValueType, Dimensions - 1, Order>
+mean(const parallel_policy& policy, const array<ValueType, Dimensions, Order, Allocator>& arr, const std::size_t axis)
+{
+    assert(arr.length(axis) > 0);
+    array<ValueType, Dimensions - 1, Order> result = sum(policy, arr, axis);
+    result /= static_cast<ValueType>(arr.length(axis));
+    return result;
+}
+namespace internal
+{
+
+/// number of elements per tile of parallel_for_each()
+template <typename ValueType>
+constexpr std::size_t forEachTile() noexcept
+{
+    return (std::size_t{1} << 15) / sizeof(ValueType);  // 32 KiB
+}
+
+/// the multi-index of the first element of the `row`-th row that runs along `fixedDimension`
+/// (rows are numbered in `Order`, cf. nextRow())
+template <array_order Order, std::size_t Dimensions>
+::std::array<std::size_t, Dimensions> rowIndices(std::size_t                                  row,
+                                                 const ::std::array<std::size_t, Dimensions>& lengths,
+                                                 const std::size_t                            fixedDimension) noexcept
+{
+    ::std::array<std::size_t, Dimensions> indices{};
+    for (std::size_t rank = 0; rank < Dimensions; ++rank)
+    {
+        const std::size_t dim = dimensionByRank<Order, Dimensions>(rank);
+        if (dim != fixedDimension)
+        {
+            indices[dim] = row % lengths[dim];
+            row         /= lengths[dim];
+        }
+    }
+    return indices;
+}
+
+/// calls `function(element, indices[0], indices[1], ...)`, with `indices[dim]` replaced by `index`
+template <typename Function, typename Element, std::size_t Dimensions, std::size_t... Dims>
+void invokeWithIndices(const Function& function, Element& element,
+                       const ::std::array<std::size_t, Dimensions>& indices, const std::size_t dim, const std::size_t index,
+                       index_sequence<Dims...>)
+{
+    function(element, ((Dims == dim) ? index : indices[Dims])...);
+}
+
+/// calls `function(element, i, j, k, ...)` for the elements `[first, last)` of a row that runs along `dim`
+/// @note `Dim` is either `dim` or `Dimensions`, i.e. any dimension (making `Dim == dim` a compile-time constant
+///       in the common case allows the compiler to vectorize the loop)
+template <std::size_t Dim, typename Function, typename ValueType, std::size_t Dimensions>
+void forEachInRow(const Function& function, ValueType* const element, const std::ptrdiff_t stride,
+                  const ::std::array<std::size_t, Dimensions>& indices, const std::size_t dim,
+                  const std::size_t first, const std::size_t last)
+{
+    const std::size_t rowDim = (Dim < Dimensions) ? Dim : dim;
+    for (std::size_t index = first; index < last; ++index)
+    {
+        invokeWithIndices(function, element[static_cast<std::ptrdiff_t>(index - first) * stride],
+                          indices, rowDim, index, make_index_sequence<Dimensions>());
+    }
+}
+
+}
+
+/// Calls `function(element, i, j, k, ...)` for each element of `view`, in parallel
+///
+/// The elements are split into tiles of contiguous (parts of) rows, which are scheduled on policy.pool().
+/// Within a tile, the element and its multi-index are updated incrementally: the function receives both
+/// without any per-element index computations.
+///
+/// Usage:
+/// @code
+///     hyper_array::parallel_for_each(hyper_array::par, arr, [](double& x, std::size_t i, std::size_t j, std::size_t k) {
+///         x = static_cast<double>(i + j + k);
+///     });
+/// @endcode
+///
+/// @note the order in which the elements are visited is unspecified
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Function>
+void parallel_for_each(const parallel_policy&                          policy,
+                       const array_view<ValueType, Dimensions, Order>& view,
+                       const Function&                                 function)  ///< `void(ValueType&, std::size_t...)`
+{
+    if (view.size() == 0)
+    {
+        return;
+    }
+
+    const ::std::array<std::size_t, Dimensions>& lengths = view.lengths();
+    const std::size_t    dim    = internal::innermostDimension(lengths, view.coeffs());
+    const std::ptrdiff_t stride = view.coeff(dim);
+    const std::size_t    length = lengths[dim];
+    const std::size_t    rows   = view.size() / length;
+    constexpr std::size_t fastestDim = internal::dimensionByRank<Order, Dimensions>(0);
+
+    // a tile is either a part of a row, or a set of complete rows
+    constexpr std::size_t tile        = internal::forEachTile<typename std::remove_const<ValueType>::type>();
+    const std::size_t     partsPerRow = (length + tile - 1) / tile;
+    const std::size_t     partLength  = (length + partsPerRow - 1) / partsPerRow;
+    const std::size_t     rowsPerTile = (partsPerRow > 1) ? 1 : ((tile / length > 0) ? tile / length : 1);
+    const std::size_t     tiles       = (partsPerRow > 1) ? rows * partsPerRow : (rows + rowsPerTile - 1) / rowsPerTile;
+
+    policy.pool().parallel_for(tiles, [&](const std::size_t t) {
+        const std::size_t firstRow = (partsPerRow > 1) ? t / partsPerRow : t * rowsPerTile;
+        const std::size_t lastRow  = (partsPerRow > 1) ? firstRow + 1 : ((firstRow + rowsPerTile < rows) ? firstRow + rowsPerTile : rows);
+        const std::size_t first    = (partsPerRow > 1) ? (t % partsPerRow) * partLength : 0;
+        const std::size_t last     = (first + partLength < length) ? first + partLength : length;
+
+        ::std::array<std::size_t, Dimensions> indices = internal::rowIndices<Order>(firstRow, lengths, dim);
+        for (std::size_t row = firstRow; row < lastRow; ++row)
+        {
+            indices[dim] = first;
+            ValueType* const element = view.data() + internal::stridedOffset(view.coeffs(), indices);
+            if ((dim == fastestDim) && (stride == 1))
+            {
+                internal::forEachInRow<fastestDim>(function, element, 1, indices, dim, first, last);
+            }
+            else
+            {
+                internal::forEachInRow<Dimensions>(function, element, stride, indices, dim, first, last);
+            }
+            internal::nextRow<Order>(indices, lengths, dim);
+        }
+    });
+}
+
+/// Calls `function(element, i, j, k, ...)` for each element of `arr`, in parallel
+/// @see parallel_for_each(const parallel_policy&, const array_view&, const Function&)
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator, typename Function>
+void parallel_for_each(const parallel_policy& policy, array<ValueType, Dimensions, Order, Allocator>& arr, const Function& function)
+{
+    parallel_for_each(policy, arr.view(), function);
+}
+
+/// @see parallel_for_each(const parallel_policy&, array&, const Function&)
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator, typename Function>
+void parallel_for_each(const parallel_policy& policy, const array<ValueType, Dimensions, Order, Allocator>& arr, const Function& function)
+{
+    parallel_for_each(policy, arr.view(), function);
+}
+
+/// Calls `function(element, i, j, k, ...)` for each element of `arr`, on default_thread_pool()
+template <typename Array, typename Function>
+auto parallel_for_each(Array&& arr, const Function& function)
+-> decltype(parallel_for_each(par, std::forward<Array>(arr), function))
+{
+    parallel_for_each(par, std::forward<Array>(arr), function);
+}
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Static Arrays">
+/// designates a dimension whose length is only known at run-time
+/// @see hyper_array::extents
+constexpr std::size_t dynamic_extent = static_cast<std::size_t>(-1);
+
+/// the length of each dimension of a hyper array
+///
+/// Each length is either known at compile-time or is `dynamic_extent`, in which case
+/// it is provided at run-time. Only the dynamic lengths are stored.
+/// @see hyper_array::static_array
+/// @see hyper_array::extents_array
+template <std::size_t... Lengths>
+class extents
+{
+public:
+
+    using size_type = std::size_t;
+
+    /// number of dimensions
+    static constexpr size_type rank() noexcept { return sizeof...(Lengths); }
+
+    /// number of dimensions whose length is only known at run-time
+    static constexpr size_type rank_dynamic() noexcept
+    {
+        return internal::ct_count_range(dynamic_extent, 0, sizeof...(Lengths), 0, Lengths...);
+    }
+
+    /// the compile-time length of a dimension, or `dynamic_extent`
+    static constexpr size_type static_extent(const size_type dimensionIndex) noexcept
+    {
+        return internal::ct_prod_range(dimensionIndex, dimensionIndex + 1, 0, Lengths...);
+    }
+
+    extents() = default;
+
+    /// @param dynamicLengths the lengths of the `dynamic_extent` dimensions, in order
+    template <
+        typename... DynamicLengths,
+        typename = internal::enable_if_t<
+            (sizeof...(DynamicLengths) == internal::ct_count_range(dynamic_extent, 0, sizeof...(Lengths), 0, Lengths...))
+            && (sizeof...(DynamicLengths) > 0)
+            && internal::are_integral<DynamicLengths...>::value,
+            void>
+    >
+    explicit extents(DynamicLengths... dynamicLengths) noexcept
+    : _dynamicLengths{{static_cast<size_type>(dynamicLengths)...}}
+    {}
+
+    /// the length of a dimension
+    size_type extent(const size_type dimensionIndex) const noexcept
+    {
+        return (static_extent(dimensionIndex) == dynamic_extent)
+             ? _dynamicLengths[internal::ct_count_range(dynamic_extent, 0, dimensionIndex, 0, Lengths...)]
+             : static_extent(dimensionIndex);
+    }
+
+    /// the lengths of all the dimensions
+    ::std::array<size_type, sizeof...(Lengths)> lengths() const noexcept
+    {
+        ::std::array<size_type, sizeof...(Lengths)> result;
+        for (size_type i = 0; i < rank(); ++i)
+        {
+            result[i] = extent(i);
+        }
+        return result;
+    }
+
+private:
+
+    /// the lengths of the `dynamic_extent` dimensions
+    ::std::array<size_type, internal::ct_count_range(dynamic_extent, 0, sizeof...(Lengths), 0, Lengths...)> _dynamicLengths = {};
+};
+
+template <typename ValueType, typename Extents, array_order Order = array_order::ROW_MAJOR>
+class static_array;
+
+/// A multi-dimensional array whose dimension lengths are known at compile-time
+///
+/// The elements are stored inline (i.e. no heap allocation) and the index coefficients
+/// are compile-time constants, so that element access boils down to immediate-offset addressing.
+///
+/// Usage:
+/// @code
+///     hyper_array::static_array<float, hyper_array::extents<4, 4, 3>> kernel{};  // zero-initialized
+///     kernel(3, 1, 2) = 3.14f;
+/// @endcode
+template <typename ValueType, std::size_t... Lengths, array_order Order>
+class static_array<ValueType, extents<Lengths...>, Order>
+{
+    static_assert(sizeof...(Lengths) > 0, "hyper_array::static_array needs at least one dimension");
+    static_assert(extents<Lengths...>::rank_dynamic() == 0, "hyper_array::static_array can't have dynamic extents, "
+                                                             "use hyper_array::extents_array instead");
+
+    // Types ///////////////////////////////////////////////////////////////////////////////////////
+
+public:
+
+    // <editor-fold defaultstate="collapsed" desc="STL-like types">
+    using value_type             = ValueType;
+    using pointer                = value_type*;
+    using const_pointer          = const value_type*;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using iterator               = value_type*;
+    using const_iterator         = const value_type*;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    // others
+    using array_type             = static_array<value_type, extents<Lengths...>, Order>;
+    using extents_type           = extents<Lengths...>;
+    using index_type             = std::size_t;
+    // </editor-fold>
+
+private:
+
+    static constexpr size_type Dimensions = sizeof...(Lengths);
+    static constexpr size_type Size       = internal::ct_prod_range(0, Dimensions, 0, Lengths...);
+
+    // Attributes //////////////////////////////////////////////////////////////////////////////////
+
+    // <editor-fold desc="Class Attributes">
+    /// the elements, stored inline
+    ::std::array<value_type, Size> _data;
+    // </editor-fold>
+
+    // methods /////////////////////////////////////////////////////////////////////////////////////
+
+public:
+
+    // <editor-fold defaultstate="collapsed" desc="Constructors">
+    /// the elements are default-initialized (like ::std::array's)
+    /// use `static_array<...> arr{};` in order to value-initialize them
+    static_array() = default;
+
+    /// Creates a new static array from an initializer list
+    static_array(std::initializer_list<value_type> values,        ///< {the initializer list}
+                 const value_type&                 defaultValue = {}  ///< default value, in case `values.size() < size()`
+    )
+    {
+        assert(values.size() <= size());
+
+        std::copy(values.begin(), values.end(), _data.begin());
+        std::fill(_data.begin() + static_cast<difference_type>(values.size()), _data.end(), defaultValue);
+    }
+    // </editor-fold>
+
+    // <editor-fold defaultstate="collapsed" desc="Whole-Array Iterators">
+    // from <array>
+          iterator         begin()         noexcept { return iterator(data());                }
+    const_iterator         begin()   const noexcept { return const_iterator(data());          }
+          iterator         end()           noexcept { return iterator(data() + size());       }
+    const_iterator         end()     const noexcept { return const_iterator(data() + size()); }
+          reverse_iterator rbegin()        noexcept { return reverse_iterator(end());         }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end());   }
+          reverse_iterator rend()          noexcept { return reverse_iterator(begin());       }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+    const_iterator         cbegin()  const noexcept { return const_iterator(data());          }
+    const_iterator         cend()    const noexcept { return const_iterator(data() + size()); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end());   }
+    const_reverse_iterator crend()   const noexcept { return const_reverse_iterator(begin()); }
+    // </editor-fold>
+
+    // <editor-fold defaultstate="collapsed" desc="Template Arguments">
+    /// number of dimensions
+    static constexpr size_type   dimensions() noexcept { return Dimensions; }
+    /// the convention used for arranging the elements
+    static constexpr array_order order()      noexcept { return Order;      }
+    // </editor-fold>
+
+    /// Returns the length of a given dimension
+    static constexpr size_type length(const size_type dimensionIndex) noexcept
+    {
+        return internal::ct_prod_range(dimensionIndex, dimensionIndex + 1, 0, Lengths...);
+    }
+
+    /// Returns the lengths of all the dimensions
+    static constexpr ::std::array<size_type, Dimensions> lengths() noexcept
+    {
+        return {{Lengths...}};
+    }
+
+    /// Returns the given dimension's coefficient (used for computing the "linear" index)
+    static constexpr size_type coeff(const size_type coeffIndex) noexcept
+    {
+        return internal::ct_index_coeff<Order>(coeffIndex, Lengths...);
+    }
+
+    /// Returns the coefficients of all the dimensions
+    static constexpr ::std::array<size_type, Dimensions> coeffs() noexcept
+    {
+        return computeCoeffs(internal::make_index_sequence<Dimensions>());
+    }
+
+    /// Returns the total number of elements in data
+    static constexpr size_type size() noexcept
+    {
+        return Size;
+    }
+
+    /// Returns a pointer to the data array
+    value_type* data() noexcept
+    {
+        return _data.data();
+    }
+
+    /// `const` version of data()
+    const value_type* data() const noexcept
+    {
+        return _data.data();
+    }
+
+    /// Returns the element at index `idx` in the data array
+    value_type& operator[](const index_type idx)
+    {
+        return _data[idx];
+    }
+
+    /// `const` version of operator[]
+    const value_type& operator[](const index_type idx) const
+    {
+        return _data[idx];
+    }
+
+    /// Returns the element at the given index tuple
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        value_type&>
+    at(Indices... indices)
+    {
+        return _data[rawIndex(indices...)];
+    }
+
+    /// `const` version of at()
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        const value_type&>
+    at(Indices... indices) const
+    {
+        return _data[rawIndex(indices...)];
+    }
+
+    /// Unchecked version of at()
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        value_type&>
+    operator()(Indices... indices)
+    {
+        return _data[rawIndex_noChecks(internal::make_index_sequence<Dimensions>(), static_cast<index_type>(indices)...)];
+    }
+
+    /// `const` version of operator()
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        const value_type&>
+    operator()(Indices... indices) const
+    {
+        return _data[rawIndex_noChecks(internal::make_index_sequence<Dimensions>(), static_cast<index_type>(indices)...)];
+    }
+
+    /// returns the actual index of the element in the data array
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        index_type>
+    rawIndex(Indices... indices) const
+    {
+        internal::validateIndices<index_type>(lengths(), indices...);
+        return rawIndex_noChecks(internal::make_index_sequence<Dimensions>(), static_cast<index_type>(indices)...);
+    }
+
+private:
+
+    template <std::size_t... Dims>
+    static constexpr ::std::array<size_type, Dimensions> computeCoeffs(internal::index_sequence<Dims...>) noexcept
+    {
+        return {{coeff(Dims)...}};
+    }
+
+    /// the coefficients are compile-time constants
+    template <std::size_t... Dims, typename... Indices>
+    static constexpr index_type rawIndex_noChecks(internal::index_sequence<Dims...>, const Indices... indices) noexcept
+    {
+        return internal::ct_sum(
+            (std::integral_constant<size_type, internal::ct_index_coeff<Order>(Dims, Lengths...)>::value * indices)...);
+    }
+};
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Mixed Extents Arrays">
+template <
+    typename    ValueType,
+    typename    Extents,
+    array_order Order     = array_order::ROW_MAJOR,
+    typename    Allocator = std::allocator<ValueType>
+>
+class extents_array;
+
+/// A multi-dimensional array whose dimension lengths are either known at compile-time,
+/// or at run-time (`dynamic_extent`)
+///
+/// Only the run-time lengths and index coefficients are stored. The other coefficients are
+/// compile-time constants, e.g. the index computation of a `{N, 3}` row-major array
+/// only involves constants, which makes its memory footprint and element access cheaper than hyper_array::array's.
+///
+/// Usage:
+/// @code
+///     using hyper_array::dynamic_extent;
+///     hyper_array::extents_array<float, hyper_array::extents<dynamic_extent, 3>> points{pointCount};
+///     points(42, 2) = 3.14f;
+/// @endcode
+template <typename ValueType, std::size_t... Lengths, array_order Order, typename Allocator>
+class extents_array<ValueType, extents<Lengths...>, Order, Allocator>
+: private internal::dynamic_coeffs_storage<
+      internal::ct_dynamic_coeff_index<Order>(sizeof...(Lengths), dynamic_extent, Lengths...)>
+{
+    static_assert(sizeof...(Lengths) > 0, "hyper_array::extents_array needs at least one dimension");
+
+    // Types ///////////////////////////////////////////////////////////////////////////////////////
+
+public:
+
+    // <editor-fold defaultstate="collapsed" desc="STL-like types">
+    using value_type             = ValueType;
+    using pointer                = value_type*;
+    using const_pointer          = const value_type*;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using iterator               = value_type*;
+    using const_iterator         = const value_type*;
+    using size_type              = std::size_t;
+    using difference_type        = std::ptrdiff_t;
+    using reverse_iterator       = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    // others
+    using array_type             = extents_array<value_type, extents<Lengths...>, Order, Allocator>;
+    using extents_type           = extents<Lengths...>;
+    using index_type             = std::size_t;
+    using allocator_type         = Allocator;
+    // </editor-fold>
+
+private:
+
+    static constexpr size_type Dimensions = sizeof...(Lengths);
+
+    using coeffs_storage_type    = internal::dynamic_coeffs_storage<
+                                       internal::ct_dynamic_coeff_index<Order>(Dimensions, dynamic_extent, Lengths...)>;
+    using deleter_type           = internal::allocator_deleter<allocator_type>;
+    using data_owner_type        = std::unique_ptr<value_type[], deleter_type>;
+
+    // Attributes //////////////////////////////////////////////////////////////////////////////////
+
+    // <editor-fold desc="Class Attributes">
+    /// the run-time lengths
+    extents_type _extents;
+
+    /// total number of elements in the data array
+    size_type _size;
+
+    /// handles the lifecycle of the dynamically allocated data array
+    data_owner_type _dataOwner;
+    // </editor-fold>
+
+    // methods /////////////////////////////////////////////////////////////////////////////////////
+
+public:
+
+    // <editor-fold defaultstate="collapsed" desc="Constructors">
+    /// copy-constructor
+    extents_array(const array_type& other)
+    : coeffs_storage_type(other)
+    , _extents   (other._extents)
+    , _size      (other._size)
+    , _dataOwner {other.cloneData(
+                      std::allocator_traits<allocator_type>::select_on_container_copy_construction(
+                          other.get_allocator()))}
+    {}
+
+    /// move constructor
+    extents_array(array_type&& other)
+    : coeffs_storage_type(other)
+    , _extents   (other._extents)
+    , _size      (other._size)
+    , _dataOwner {std::move(other._dataOwner)}
+    {}
+
+    /// the usual way of constructing mixed extents arrays
+    /// @param dynamicLengths the lengths of the `dynamic_extent` dimensions, in order
+    template <
+        typename... DynamicLengths,
+        typename = internal::enable_if_t<
+            (sizeof...(DynamicLengths) == extents_type::rank_dynamic()) && internal::are_integral<DynamicLengths...>::value,
+            void>
+    >
+    extents_array(DynamicLengths... dynamicLengths)
+    : extents_array(extents_type(dynamicLengths...))
+    {}
+
+    /// Creates a mixed extents array given its extents
+    explicit extents_array(const extents_type&   ext,                          ///< the lengths
+                           const allocator_type& allocator = allocator_type()  ///< allocates/releases the data array
+    )
+    : _extents   (ext)
+    , _size      (computeDataSize(_extents))
+    , _dataOwner {deleter_type::allocate(allocator, _size), deleter_type{allocator, _size}}
+    {
+        initDynamicCoeffs();
+    }
+
+    /// Creates a mixed extents array whose elements are left uninitialized
+    /// @see array(uninitialized_t, DimensionLengths...)
+    extents_array(uninitialized_t,
+                  const extents_type&   ext,                          ///< the lengths
+                  const allocator_type& allocator = allocator_type()  ///< allocates/releases the data array
+    )
+    : _extents   (ext)
+    , _size      (computeDataSize(_extents))
+    , _dataOwner {deleter_type::allocate(allocator, _size, uninitialized), deleter_type{allocator, _size}}
+    {
+        initDynamicCoeffs();
+    }
+    // </editor-fold>
+
+    // <editor-fold defaultstate="collapsed" desc="Assignment Operators">
+    /// copy assignment
+    array_type& operator=(const array_type& other)
+    {
+        const bool propagate = std::allocator_traits<allocator_type>::propagate_on_container_copy_assignment::value;
+
+        _dataOwner = other.cloneData(propagate ? other.get_allocator() : get_allocator());
+        static_cast<coeffs_storage_type&>(*this) = other;
+        _extents   = other._extents;
+        _size      = other._size;
+
+        return *this;
+    }
+
+    /// move assignment
+    /// @see array::operator=(array_type&&)
+    array_type& operator=(array_type&& other)
+    {
+        moveAssign(other, typename std::allocator_traits<allocator_type>::propagate_on_container_move_assignment{});
+
+        return *this;
+    }
+    // </editor-fold>
+
+    // <editor-fold defaultstate="collapsed" desc="Whole-Array Iterators">
+    // from <array>
+          iterator         begin()         noexcept { return iterator(data());                }
+    const_iterator         begin()   const noexcept { return const_iterator(data());          }
+          iterator         end()           noexcept { return iterator(data() + size());       }
+    const_iterator         end()     const noexcept { return const_iterator(data() + size()); }
+          reverse_iterator rbegin()        noexcept { return reverse_iterator(end());         }
+    const_reverse_iterator rbegin()  const noexcept { return const_reverse_iterator(end());   }
+          reverse_iterator rend()          noexcept { return reverse_iterator(begin());       }
+    const_reverse_iterator rend()    const noexcept { return const_reverse_iterator(begin()); }
+    const_iterator         cbegin()  const noexcept { return const_iterator(data());          }
+    const_iterator         cend()    const noexcept { return const_iterator(data() + size()); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end());   }
+    const_reverse_iterator crend()   const noexcept { return const_reverse_iterator(begin()); }
+    // </editor-fold>
+
+    // <editor-fold defaultstate="collapsed" desc="Template Arguments">
+    /// number of dimensions
+    static constexpr size_type   dimensions() noexcept { return Dimensions; }
+    /// the convention used for arranging the elements
+    static constexpr array_order order()      noexcept { return Order;      }
+    // </editor-fold>
+
+    /// Returns a copy of the allocator that is used for the data array
+    allocator_type get_allocator() const noexcept
+    {
+        return _dataOwner.get_deleter().allocator();
+    }
+
+    /// Returns the lengths, as an extents object
+    const extents_type& get_extents() const noexcept
+    {
+        return _extents;
+    }
+
+    /// Returns the length of a given dimension at run-time
+    size_type length(const size_type dimensionIndex) const
+    {
+        assert(dimensionIndex < Dimensions);
+
+        return _extents.extent(dimensionIndex);
+    }
+
+    /// Returns the lengths of all the dimensions
+    ::std::array<size_type, Dimensions> lengths() const noexcept
+    {
+        return _extents.lengths();
+    }
+
+    /// Returns the given dimension's coefficient (used for computing the "linear" index)
+    size_type coeff(const size_type coeffIndex) const
+    {
+        assert(coeffIndex < Dimensions);
+
+        return coeffs()[coeffIndex];
+    }
+
+    /// Returns the coefficients of all the dimensions
+    ::std::array<size_type, Dimensions> coeffs() const noexcept
+    {
+        return computeCoeffs(internal::make_index_sequence<Dimensions>());
+    }
+
+    /// Returns the total number of elements in data
+    size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    /// Returns a pointer to the allocated data array
+    value_type* data() noexcept
+    {
+        return _dataOwner.get();
+    }
+
+    /// `const` version of data()
+    const value_type* data() const noexcept
+    {
+        return _dataOwner.get();
+    }
+
+    /// Returns the element at index `idx` in the data array
+    value_type& operator[](const index_type idx)
+    {
+        return _dataOwner[idx];
+    }
+
+    /// `const` version of operator[]
+    const value_type& operator[](const index_type idx) const
+    {
+        return _dataOwner[idx];
+    }
+
+    /// Returns the element at the given index tuple
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        value_type&>
+    at(Indices... indices)
+    {
+        return _dataOwner[rawIndex(indices...)];
+    }
+
+    /// `const` version of at()
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        const value_type&>
+    at(Indices... indices) const
+    {
+        return _dataOwner[rawIndex(indices...)];
+    }
+
+    /// Unchecked version of at()
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        value_type&>
+    operator()(Indices... indices)
+    {
+        return _dataOwner[rawIndex_noChecks(internal::make_index_sequence<Dimensions>(), static_cast<index_type>(indices)...)];
+    }
+
+    /// `const` version of operator()
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        const value_type&>
+    operator()(Indices... indices) const
+    {
+        return _dataOwner[rawIndex_noChecks(internal::make_index_sequence<Dimensions>(), static_cast<index_type>(indices)...)];
+    }
+
+    /// returns the actual index of the element in the data array
+    template <typename... Indices>
+    internal::enable_if_t<
+        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
+        index_type>
+    rawIndex(Indices... indices) const
+    {
+        internal::validateIndices<index_type>(lengths(), indices...);
+        return rawIndex_noChecks(internal::make_index_sequence<Dimensions>(), static_cast<index_type>(indices)...);
+    }
+
+private:
+
+    /// a coefficient that only depends on compile-time lengths is a compile-time constant
+    template <std::size_t Dim>
+    internal::enable_if_t<internal::ct_is_static_coeff<Order>(Dim, dynamic_extent, Lengths...), size_type>
+    coeffAt() const noexcept
+    {
+        return std::integral_constant<size_type, internal::ct_index_coeff<Order>(Dim, Lengths...)>::value;
+    }
+
+    /// the other coefficients are computed at construction time
+    template <std::size_t Dim>
+    internal::enable_if_t<!internal::ct_is_static_coeff<Order>(Dim, dynamic_extent, Lengths...), size_type>
+    coeffAt() const noexcept
+    {
+        return this->_dynamicCoeffs[internal::ct_dynamic_coeff_index<Order>(Dim, dynamic_extent, Lengths...)];
+    }
+
+    template <std::size_t... Dims>
+    ::std::array<size_type, Dimensions> computeCoeffs(internal::index_sequence<Dims...>) const noexcept
+    {
+        return {{coeffAt<Dims>()...}};
+    }
+
+    template <std::size_t... Dims, typename... Indices>
+    index_type rawIndex_noChecks(internal::index_sequence<Dims...>, const Indices... indices) const noexcept
+    {
+        return internal::ct_sum((coeffAt<Dims>() * indices)...);
+    }
+
+    void initDynamicCoeffs() noexcept
+    {
+        initDynamicCoeffs(internal::make_index_sequence<Dimensions>());
+    }
+
+    template <std::size_t... Dims>
+    void initDynamicCoeffs(internal::index_sequence<Dims...>) noexcept
+    {
+        this->setDynamicCoeffs(internal::computeIndexCoeffs<size_type, Dimensions, Order>(_extents.lengths()),
+                               ::std::array<bool, Dimensions>{{
+                                   internal::ct_is_static_coeff<Order>(Dims, dynamic_extent, Lengths...)...}});
+    }
+
+    /// computes the total number of elements in a data array
+    static
+    size_type
+    computeDataSize(const extents_type& ext) noexcept
+    {
+        size_type result = 1;
+        for (size_type i = 0; i < Dimensions; ++i)
+        {
+            result *= ext.extent(i);
+        }
+        return result;
+    }
+
+    data_owner_type cloneData(const allocator_type& allocator) const
+    {
+        return data_owner_type{deleter_type::clone(allocator, _dataOwner.get(), size()),
+                               deleter_type{allocator, size()}};
+    }
+
+    /// move assignment, when the allocator is propagated
+    void moveAssign(array_type& other, std::true_type)
+    {
+        static_cast<coeffs_storage_type&>(*this) = other;
+        _extents   = other._extents;
+        _size      = other._size;
+        _dataOwner = std::move(other._dataOwner);
+    }
+
+    /// move assignment, when the allocator isn't propagated
+    void moveAssign(array_type& other, std::false_type)
+    {
+        const allocator_type allocator = get_allocator();
+        value_type* const    data      = ((allocator == other.get_allocator()) || (other._dataOwner == nullptr))
+                                       ? other._dataOwner.release()
+                                       : deleter_type::clone(allocator, std::make_move_iterator(other._dataOwner.get()), other._size);
+
+        static_cast<coeffs_storage_type&>(*this) = other;
+        _extents   = other._extents;
+        _size      = other._size;
+        _dataOwner = data_owner_type{data, deleter_type{allocator, _size}};
+    }
+};
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="File Storage">
+/*
+ * hyper_array files consist of a small header followed by the elements, in the array's order:
+ *
+ *   offset  size  field
+ *        0     8  magic: "HYPERARR"
+ *        8     4  byte order marker: 0x01020304, as written by the machine that created the file
+ *       12     1  version: 1
+ *       13     1  order: 0 (ROW_MAJOR) or 1 (COLUMN_MAJOR)
+ *       14     1  element kind: 'b' (bool), 'i' (signed), 'u' (unsigned), 'f' (floating point), 'V' (other)
+ *       15     1  number of dimensions, D
+ *       16     4  element size, in bytes
+ *       20     4  offset of the first element (a multiple of 64)
+ *       24  8 x D length of each dimension
+ *
+ * The header is native-endian: files are meant to be mapped in memory as-is, not exchanged between architectures.
+ */
+namespace internal
+{
+
+/// fixed part of the header of hyper_array files
+struct file_header
+{
+    char          magic[8];
+    std::uint32_t byteOrder;
+    std::uint8_t  version;
+    std::uint8_t  order;
+    char          kind;
+    std::uint8_t  dimensions;
+    std::uint32_t elementSize;
+    std::uint32_t dataOffset;
+};
+
+static_assert(sizeof(file_header) == 24, "unexpected padding in hyper_array::internal::file_header");
+
+constexpr std::uint32_t fileByteOrder = 0x01020304;
+constexpr std::uint8_t  fileVersion   = 1;
+
+/// the element kind that is stored in the header of hyper_array files
+template <typename T>
+constexpr char fileElementKind() noexcept
+{
+    return std::is_same<T, bool>::value     ? 'b'
+         : std::is_floating_point<T>::value ? 'f'
+         : std::is_signed<T>::value         ? 'i'
+         : std::is_unsigned<T>::value       ? 'u'
+         :                                    'V';
+}
+
+/// size of the header of hyper_array files, i.e. offset of the first element
+template <std::size_t Dimensions>
+constexpr std::size_t fileDataOffset() noexcept
+{
+    return (sizeof(file_header) + Dimensions * sizeof(std::uint64_t) + 63) / 64 * 64;
+}
+
+/// what the header of a hyper_array file describes
+template <std::size_t Dimensions>
+struct file_info
+{
+    ::std::array<std::size_t, Dimensions> lengths;
+    array_order                           order;
+    std::size_t                           dataOffset;  ///< in bytes
+    std::size_t                           dataSize;    ///< in bytes
+    bool                                  byteSwapped; ///< whether the elements are in the other byte order (.npy files)
+};
+
+/// writes the header of a file that stores `lengths` `ValueType` elements in `order`
+/// @note `out` must hold fileDataOffset<Dimensions>() bytes
+template <typename ValueType, std::size_t Dimensions>
+void encodeFileHeader(unsigned char* out, const ::std::array<std::size_t, Dimensions>& lengths, const array_order order) noexcept
+{
+    static_assert(Dimensions <= 255, "hyper_array files support up to 255 dimensions");
+
+    const file_header header{
+        {'H', 'Y', 'P', 'E', 'R', 'A', 'R', 'R'},
+        fileByteOrder,
+        fileVersion,
+        static_cast<std::uint8_t>(order),
+        fileElementKind<ValueType>(),
+        static_cast<std::uint8_t>(Dimensions),
+        static_cast<std::uint32_t>(sizeof(ValueType)),
+        static_cast<std::uint32_t>(fileDataOffset<Dimensions>())
+    };
+    std::memset(out, 0, fileDataOffset<Dimensions>());
+    std::memcpy(out, &header, sizeof(header));
+    for (std::size_t i = 0; i < Dimensions; ++i)
+    {
+        const std::uint64_t length = lengths[i];
+        std::memcpy(out + sizeof(header) + i * sizeof(length), &length, sizeof(length));
+    }
+}
+
+/// size of the elements of a hyper_array file, in bytes
+/// @throw std::length_error if it can't be represented by `std::size_t`
+template <typename ValueType, std::size_t Dimensions>
+std::size_t fileDataSize(const ::std::array<std::size_t, Dimensions>& lengths)
+{
+    std::size_t result = sizeof(ValueType);
+    bool        overflow = false;
+    for (std::size_t i = 0; i < Dimensions; ++i)
+    {
+        if (lengths[i] == 0)
+        {
+            return 0;
+        }
+        overflow = overflow || (result > std::numeric_limits<std::size_t>::max() / lengths[i]);
+        result  *= lengths[i];
+    }
+    if (overflow)
+    {
+        throw std::length_error("hyper_array: the size of the file's data overflows std::size_t");
+    }
+    return result;
+}
+
+[[noreturn]] HYPER_ARRAY_NOINLINE
+inline void fileFormatError(const std::string& path, const char* what)
+{
+    throw std::runtime_error("hyper_array: " + path + ": " + what);
+}
+
+/// reads the header of a file that is expected to store `ValueType` elements in `Dimensions` dimensions
+/// @throw std::runtime_error if the header is invalid or describes another kind of array
+template <typename ValueType, std::size_t Dimensions>
+file_info<Dimensions> decodeFileHeader(const unsigned char* in, const std::size_t available, const std::string& path)
+{
+    if (available < sizeof(file_header) + Dimensions * sizeof(std::uint64_t))
+    {
+        fileFormatError(path, "the file is too small for a hyper_array header");
+    }
+    file_header header;
+    std::memcpy(&header, in, sizeof(header));
+    if (std::memcmp(header.magic, "HYPERARR", sizeof(header.magic)) != 0)
+    {
+        fileFormatError(path, "not a hyper_array file");
+    }
+    if (header.byteOrder != fileByteOrder)
+    {
+        fileFormatError(path, "the file was written with another byte order");
+    }
+    if (header.version != fileVersion)
+    {
+        fileFormatError(path, "unsupported version");
+    }
+    if (header.order > static_cast<std::uint8_t>(array_order::COLUMN_MAJOR))
+    {
+        fileFormatError(path, "invalid array order");
+    }
+    if (header.dimensions != Dimensions)
+    {
+        fileFormatError(path, "the number of dimensions doesn't match");
+    }
+    if ((header.kind != fileElementKind<ValueType>()) || (header.elementSize != sizeof(ValueType)))
+    {
+        fileFormatError(path, "the element type doesn't match");
+    }
+    if ((header.dataOffset < sizeof(file_header) + Dimensions * sizeof(std::uint64_t)) || (header.dataOffset % 64 != 0))
+    {
+        fileFormatError(path, "invalid data offset");
+    }
+
+    file_info<Dimensions> info;
+    for (std::size_t i = 0; i < Dimensions; ++i)
+    {
+        std::uint64_t length;
+        std::memcpy(&length, in + sizeof(header) + i * sizeof(length), sizeof(length));
+        if (length > std::numeric_limits<std::size_t>::max())
+        {
+            fileFormatError(path, "a length overflows std::size_t");
+        }
+        info.lengths[i] = static_cast<std::size_t>(length);
+    }
+    info.order       = static_cast<array_order>(header.order);
+    info.dataOffset  = header.dataOffset;
+    info.dataSize    = fileDataSize<ValueType>(info.lengths);
+    info.byteSwapped = false;
+    return info;
+}
+
+constexpr array_order otherOrder(const array_order order) noexcept
+{
+    return (order == array_order::ROW_MAJOR) ? array_order::COLUMN_MAJOR : array_order::ROW_MAJOR;
+}
+
+/// strides of a dense array that is laid out in a run-time `order`
+template <std::size_t Dimensions>
+::std::array<std::ptrdiff_t, Dimensions> denseStrides(const ::std::array<std::size_t, Dimensions>& lengths, const array_order order) noexcept
+{
+    return toStrides(order == array_order::ROW_MAJOR
+                     ? computeIndexCoeffs<std::size_t, Dimensions, array_order::ROW_MAJOR   >(lengths)
+                     : computeIndexCoeffs<std::size_t, Dimensions, array_order::COLUMN_MAJOR>(lengths));
+}
+
+[[noreturn]] HYPER_ARRAY_NOINLINE
+inline void fileSystemError(const char* function, const std::string& path)
+{
+    throw std::system_error(errno, std::generic_category(), std::string("hyper_array: ") + function + "(" + path + ")");
+}
+
+/// closes a std::FILE
+struct file_closer
+{
+    void operator()(std::FILE* file) const noexcept { std::fclose(file); }
+};
+
+using file_ptr = std::unique_ptr<std::FILE, file_closer>;
+
+/// opens an unbuffered file: the elements are read and written in bulk, stdio's buffer would only add a copy
+inline file_ptr openFile(const std::string& path, const char* mode)
+{
+    file_ptr file{std::fopen(path.c_str(), mode)};
+    if (!file)
+    {
+        fileSystemError("fopen", path);
+    }
+    std::setvbuf(file.get(), nullptr, _IONBF, 0);
+    return file;
+}
+
+inline void readFile(std::FILE* file, void* data, const std::size_t size, const std::string& path)
+{
+    if (std::fread(data, 1, size, file) != size)
+    {
+        if (std::feof(file))
+        {
+            fileFormatError(path, "the file is truncated");
+        }
+        fileSystemError("fread", path);
+    }
+}
+
+inline void writeFile(std::FILE* file, const void* data, const std::size_t size, const std::string& path)
+{
+    if (std::fwrite(data, 1, size, file) != size)
+    {
+        fileSystemError("fwrite", path);
+    }
+}
+
+/// moves to `offset` bytes from the beginning of the file, beyond 2 GiB where `long` is 32-bit
+inline void seekFile(std::FILE* file, const std::size_t offset, const std::string& path)
+{
+    #if defined(_WIN32)
+    const int status = ::_fseeki64(file, static_cast<long long>(offset), SEEK_SET);
+    #else
+    const int status = ::fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+    #endif
+    if (status != 0)
+    {
+        fileSystemError("fseek", path);
+    }
+}
+
+/// size of the file in bytes
+/// @note the file's position is moved to its end
+inline std::size_t fileSize(std::FILE* file, const std::string& path)
+{
+    #if defined(_WIN32)
+    const long long size = (::_fseeki64(file, 0, SEEK_END) == 0) ? ::_ftelli64(file) : -1;
+    #else
+    const off_t     size = (::fseeko(file, 0, SEEK_END) == 0) ? ::ftello(file) : -1;
+    #endif
+    if (size < 0)
+    {
+        fileSystemError("ftell", path);
+    }
+    return static_cast<std::size_t>(size);
+}
+
+/// the hyper_array file format, cf. above
+struct native_file_format
+{
+    template <typename ValueType, std::size_t Dimensions>
+    static std::vector<unsigned char> encode(const ::std::array<std::size_t, Dimensions>& lengths, const array_order order)
+    {
+        std::vector<unsigned char> header(fileDataOffset<Dimensions>());
+        encodeFileHeader<ValueType>(header.data(), lengths, order);
+        return header;
+    }
+
+    template <typename ValueType, std::size_t Dimensions>
+    static file_info<Dimensions> decode(const unsigned char* in, const std::size_t available, const std::string& path)
+    {
+        return decodeFileHeader<ValueType, Dimensions>(in, available, path);
+    }
+
+    /// reads the header, and moves to the first element
+    template <typename ValueType, std::size_t Dimensions>
+    static file_info<Dimensions> read(std::FILE* file, const std::string& path)
+    {
+        unsigned char header[fileDataOffset<Dimensions>()];
+        readFile(file, header, sizeof(header), path);
+        const auto info = decodeFileHeader<ValueType, Dimensions>(header, sizeof(header), path);
+        if ((info.dataOffset != sizeof(header)) && (std::fseek(file, static_cast<long>(info.dataOffset), SEEK_SET) != 0))
+        {
+            fileSystemError("fseek", path);
+        }
+        return info;
+    }
+};
+
+/*
+ * NumPy's .npy files consist of:
+ * - a preamble: "\x93NUMPY", the major and minor versions (1 byte each), and the length of the header
+ *   (2 bytes in version 1.0, 4 bytes in versions 2.0 and 3.0, little-endian)
+ * - the header: a Python dict literal, padded with spaces and terminated by '\n', such as
+ *   `{'descr': '<f8', 'fortran_order': False, 'shape': (3, 4), }`
+ *   where `descr` is the byte order ('<', '>', '|' or '='), the kind and the size of the elements
+ * - the elements, either in C order (i.e. ROW_MAJOR) or in Fortran order (i.e. COLUMN_MAJOR)
+ * cf. https://numpy.org/doc/stable/reference/generated/numpy.lib.format.html
+ */
+
+inline bool isLittleEndian() noexcept
+{
+    const std::uint16_t one = 1;
+    unsigned char       first;
+    std::memcpy(&first, &one, 1);
+    return first == 1;
+}
+
+/// NumPy's type description of `ValueType`, e.g. "<f8"
+template <typename ValueType>
+std::string npyDescr()
+{
+    static_assert(fileElementKind<ValueType>() != 'V', ".npy files only support bool, integer and floating point elements");
+
+    const char byteOrder = (sizeof(ValueType) == 1) ? '|' : (isLittleEndian() ? '<' : '>');
+    return byteOrder + std::string(1, fileElementKind<ValueType>()) + std::to_string(sizeof(ValueType));
+}
+
+template <typename ValueType, std::size_t Dimensions>
+std::vector<unsigned char> encodeNpyHeader(const ::std::array<std::size_t, Dimensions>& lengths, const array_order order)
+{
+    std::string dict = "{'descr': '" + npyDescr<ValueType>() + "', 'fortran_order': "
+                     + ((order == array_order::COLUMN_MAJOR) ? "True" : "False") + ", 'shape': (";
+    for (std::size_t i = 0; i < Dimensions; ++i)
+    {
+        dict += std::to_string(lengths[i]) + ((i + 1 < Dimensions) ? ", " : "");
+    }
+    dict += (Dimensions == 1) ? ",), }" : "), }";
+
+    // version 1.0 unless the header doesn't fit in 64 KiB, the elements start at a multiple of 64 bytes
+    const std::size_t preamble = (dict.size() + 64 < 65536) ? 10 : 12;
+    const std::size_t total    = (preamble + dict.size() + 1 + 63) / 64 * 64;
+    const std::size_t length   = total - preamble;
+    dict.append(length - dict.size() - 1, ' ');
+    dict += '\n';
+
+    std::vector<unsigned char> header{0x93, 'N', 'U', 'M', 'P', 'Y', static_cast<unsigned char>(preamble == 10 ? 1 : 2), 0};
+    for (std::size_t i = 8; i < preamble; ++i)
+    {
+        header.push_back(static_cast<unsigned char>(length >> (8 * (i - 8))));
+    }
+    header.insert(header.end(), dict.begin(), dict.end());
+    return header;
+}
+
+/// position of the value of `key` in the header of a .npy file
+inline std::size_t npyValue(const std::string& dict, const char* key, const std::string& path)
+{
+    std::size_t position = dict.find(std::string("'") + key + "'");
+    if (position == std::string::npos)
+    {
+        position = dict.find(std::string("\"") + key + "\"");
+    }
+    if (position != std::string::npos)
+    {
+        position = dict.find(':', position);
+    }
+    if (position != std::string::npos)
+    {
+        position = dict.find_first_not_of(" \t", position + 1);
+    }
+    if (position == std::string::npos)
+    {
+        fileFormatError(path, (std::string("the .npy header has no valid '") + key + "' entry").c_str());
+    }
+    return position;
+}
+
+/// size of the preamble and the header of a .npy file, i.e. offset of the first element
+/// @note `in` must hold at least 12 bytes
+inline std::size_t npyDataOffset(const unsigned char* in, const std::string& path)
+{
+    if (std::memcmp(in, "\x93NUMPY", 6) != 0)
+    {
+        fileFormatError(path, "not a .npy file");
+    }
+    switch (in[6])
+    {
+        case 1:  return 10 + (std::size_t{in[8]} | (std::size_t{in[9]} << 8));
+        case 2:
+        case 3:  return 12 + (std::size_t{in[8]} | (std::size_t{in[9]} << 8) | (std::size_t{in[10]} << 16) | (std::size_t{in[11]} << 24));
+        default: fileFormatError(path, "unsupported .npy version");
+    }
+}
+
+/// reads the header of a .npy file that is expected to store `ValueType` elements in `Dimensions` dimensions
+/// @throw std::runtime_error if the header is invalid or describes another kind of array
+template <typename ValueType, std::size_t Dimensions>
+file_info<Dimensions> decodeNpyHeader(const unsigned char* in, const std::size_t available, const std::string& path)
+{
+    if (available < 12)
+    {
+        fileFormatError(path, "the file is too small for a .npy header");
+    }
+    const std::size_t dataOffset = npyDataOffset(in, path);
+    const std::size_t preamble   = (in[6] == 1) ? 10 : 12;
+    if (available < dataOffset)
+    {
+        fileFormatError(path, "the file is truncated");
+    }
+    const std::string dict(reinterpret_cast<const char*>(in) + preamble, dataOffset - preamble);
+
+    file_info<Dimensions> info;
+    info.dataOffset = dataOffset;
+
+    // 'descr': the byte order is either native, or swapped when the elements are read
+    const std::size_t descrPosition = npyValue(dict, "descr", path);
+    const std::size_t descrEnd      = dict.find(dict[descrPosition], descrPosition + 1);
+    if (((dict[descrPosition] != '\'') && (dict[descrPosition] != '"')) || (descrEnd == std::string::npos) || (descrEnd - descrPosition < 3))
+    {
+        fileFormatError(path, "invalid 'descr' in the .npy header");
+    }
+    const char        byteOrder = dict[descrPosition + 1];
+    const std::string expected  = npyDescr<ValueType>();
+    if (dict.compare(descrPosition + 2, descrEnd - descrPosition - 2, expected, 1, std::string::npos) != 0)
+    {
+        fileFormatError(path, "the element type doesn't match");
+    }
+    info.byteSwapped = (sizeof(ValueType) > 1) && (byteOrder != '=') && (byteOrder != expected[0]);
+
+    // 'fortran_order'
+    const std::size_t fortranPosition = npyValue(dict, "fortran_order", path);
+    if (dict.compare(fortranPosition, 4, "True") == 0)
+    {
+        info.order = array_order::COLUMN_MAJOR;
+    }
+    else if (dict.compare(fortranPosition, 5, "False") == 0)
+    {
+        info.order = array_order::ROW_MAJOR;
+    }
+    else
+    {
+        fileFormatError(path, "invalid 'fortran_order' in the .npy header");
+    }
+
+    // 'shape': a tuple of integers
+    std::size_t position   = npyValue(dict, "shape", path);
+    std::size_t dimensions = 0;
+    if (dict[position] != '(')
+    {
+        fileFormatError(path, "invalid 'shape' in the .npy header");
+    }
+    for (++position; ; )
+    {
+        position = dict.find_first_not_of(" ,", position);
+        if ((position == std::string::npos) || (dict[position] == ')'))
+        {
+            break;
+        }
+        std::uint64_t length = 0;
+        bool          valid  = (dict[position] >= '0') && (dict[position] <= '9');
+        for (; (position < dict.size()) && (dict[position] >= '0') && (dict[position] <= '9'); ++position)
+        {
+            valid  = valid && (length <= (std::numeric_limits<std::size_t>::max() - 9) / 10);
+            length = length * 10 + static_cast<std::uint64_t>(dict[position] - '0');
+        }
+        if (!valid || (dimensions == Dimensions))
+        {
+            fileFormatError(path, valid ? "the number of dimensions doesn't match" : "invalid 'shape' in the .npy header");
+        }
+        info.lengths[dimensions++] = static_cast<std::size_t>(length);
+    }
+    if ((position == std::string::npos) || (dimensions != Dimensions))
+    {
+        fileFormatError(path, (position == std::string::npos) ? "invalid 'shape' in the .npy header" : "the number of dimensions doesn't match");
+    }
+    info.dataSize = fileDataSize<ValueType>(info.lengths);
+    return info;
+}
+
+/// NumPy's .npy file format, cf. above
+struct npy_file_format
+{
+    template <typename ValueType, std::size_t Dimensions>
+    static std::vector<unsigned char> encode(const ::std::array<std::size_t, Dimensions>& lengths, const array_order order)
+    {
+        return encodeNpyHeader<ValueType>(lengths, order);
+    }
+
+    template <typename ValueType, std::size_t Dimensions>
+    static file_info<Dimensions> decode(const unsigned char* in, const std::size_t available, const std::string& path)
+    {
+        return decodeNpyHeader<ValueType, Dimensions>(in, available, path);
+    }
+
+    /// reads the header, and moves to the first element
+    template <typename ValueType, std::size_t Dimensions>
+    static file_info<Dimensions> read(std::FILE* file, const std::string& path)
+    {
+        std::vector<unsigned char> header(12);
+        readFile(file, header.data(), header.size(), path);
+        const std::size_t dataOffset = npyDataOffset(header.data(), path);
+        if (dataOffset < header.size())
+        {
+            fileFormatError(path, "invalid .npy header length");
+        }
+        header.resize(dataOffset);
+        readFile(file, header.data() + 12, dataOffset - 12, path);
+        return decodeNpyHeader<ValueType, Dimensions>(header.data(), header.size(), path);
+    }
+};
+
+/// reverses the bytes of each element
+template <typename ValueType>
+void swapBytes(ValueType* data, const std::size_t size) noexcept
+{
+    unsigned char* bytes = reinterpret_cast<unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i, bytes += sizeof(ValueType))
+    {
+        for (std::size_t b = 0; b < sizeof(ValueType) / 2; ++b)
+        {
+            std::swap(bytes[b], bytes[sizeof(ValueType) - 1 - b]);
+        }
+    }
+}
+
+/// writes a dense data array, laid out in `order`, in two bulk writes: the header, then the elements
+template <typename Format, typename ValueType, std::size_t Dimensions>
+void saveDense(const std::string& path, const ValueType* data, const ::std::array<std::size_t, Dimensions>& lengths, const array_order order)
+{
+    static_assert(std::is_trivial<ValueType>::value, "hyper_array::save() requires trivial elements");
+
+    const std::vector<unsigned char> header   = Format::template encode<ValueType>(lengths, order);
+    const std::size_t                dataSize = fileDataSize<ValueType>(lengths);
+
+    file_ptr file = openFile(path, "wb");
+    writeFile(file.get(), header.data(), header.size(), path);
+    writeFile(file.get(), data, dataSize, path);
+    if (std::fclose(file.release()) != 0)
+    {
+        fileSystemError("fclose", path);
+    }
+}
+
+/// saves a view as-is if it's dense in either order, copies it first otherwise
+template <typename Format, typename ValueType, std::size_t Dimensions, array_order Order>
+void saveView(const std::string& path, const array_view<ValueType, Dimensions, Order>& view)
+{
+    if (view.coeffs() == denseStrides(view.lengths(), Order))
+    {
+        saveDense<Format>(path, view.data(), view.lengths(), Order);
+    }
+    else if (view.coeffs() == denseStrides(view.lengths(), otherOrder(Order)))
+    {
+        saveDense<Format>(path, view.data(), view.lengths(), otherOrder(Order));
+    }
+    else
+    {
+        const auto dense = materialize(view);
+        saveDense<Format>(path, dense.data(), view.lengths(), Order);
+    }
+}
+
+/// reads the elements of a file (whose header was already read) into a new array
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+array<ValueType, Dimensions, Order, Allocator> loadDense(std::FILE* file, const file_info<Dimensions>& info, const std::string& path)
+{
+    // checked before allocating anything, i.e. corrupted lengths can't cause huge allocations
+    const std::size_t size = fileSize(file, path);
+    if ((info.dataOffset > size) || (info.dataSize > size - info.dataOffset))
+    {
+        fileFormatError(path, "the file is truncated");
+    }
+    seekFile(file, info.dataOffset, path);
+
+    array<ValueType, Dimensions, Order, Allocator> result{uninitialized, info.lengths};
+    readFile(file, result.data(), info.dataSize, path);
+    if (info.byteSwapped)
+    {
+        swapBytes(result.data(), result.size());
+    }
+    return result;
+}
+
+/// reads a whole file, converting it to `Order` if needed
+template <typename Format, typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+array<ValueType, Dimensions, Order, Allocator> loadFile(const std::string& path)
+{
+    static_assert(std::is_trivial<ValueType>::value, "hyper_array::load() requires trivial elements");
+
+    const file_ptr file = openFile(path, "rb");
+    const auto     info = Format::template read<ValueType, Dimensions>(file.get(), path);
+    if (info.order == Order)
+    {
+        return loadDense<ValueType, Dimensions, Order, Allocator>(file.get(), info, path);
+    }
+    return array<ValueType, Dimensions, Order, Allocator>{
+        loadDense<ValueType, Dimensions, otherOrder(Order), Allocator>(file.get(), info, path)};
+}
+
+}
+
+/// Saves a hyper array in a file, in the hyper_array file format
+///
+/// The header and the elements are written in two bulk writes (i.e. without formatting or converting anything).
+/// The file can be read by load(), or mapped in memory by hyper_array::mapped_array.
+///
+/// Usage:
+/// @code
+///     hyper_array::save("grid.ha", grid);
+///     auto copy   = hyper_array::load<double, 3>("grid.ha");
+///     auto mapped = hyper_array::mapped_array<const double, 3>::open("grid.ha");  // no copy at all
+/// @endcode
+/// @throw std::system_error if the file can't be written
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+void save(const std::string& path, const array<ValueType, Dimensions, Order, Allocator>& arr)
+{
+    internal::saveDense<internal::native_file_format>(path, arr.data(), internal::convertLengths<std::size_t>(arr.lengths()), Order);
+}
+
+/// Saves a view in a file, @see save()
+/// @note views that are dense in either order (e.g. a transposed array) are written as-is, others are copied first
+template <typename ValueType, std::size_t Dimensions, array_order Order>
+void save(const std::string& path, const array_view<ValueType, Dimensions, Order>& view)
+{
+    internal::saveView<internal::native_file_format>(path, view);
+}
+
+/// Loads a hyper array from a file written by save() (or created by hyper_array::mapped_array)
+///
+/// The elements are read with a single bulk read. Files stored in the other order are converted to `Order`.
+/// @see mapped_array::open() for accessing the elements without reading (or copying) them
+/// @throw std::system_error if the file can't be read
+/// @throw std::runtime_error if it isn't a hyper_array file of `Dimensions` `ValueType` elements
+template <
+    typename    ValueType,
+    std::size_t Dimensions,
+    array_order Order     = array_order::ROW_MAJOR,
+    typename    Allocator = std::allocator<ValueType>
+>
+array<ValueType, Dimensions, Order, Allocator> load(const std::string& path)
+{
+    return internal::loadFile<internal::native_file_format, ValueType, Dimensions, Order, Allocator>(path);
+}
+
+/// Saves a hyper array in NumPy's .npy format, i.e. readable by `numpy.load()`
+///
+/// ROW_MAJOR arrays are saved in C order, COLUMN_MAJOR ones with `fortran_order` (i.e. the elements are never reordered).
+/// As with save(), the header and the elements are written in two bulk writes.
+///
+/// Usage:
+/// @code
+///     hyper_array::save_npy("grid.npy", grid);                     // np.load("grid.npy")
+///     auto copy   = hyper_array::load_npy<double, 3>("grid.npy");  // np.save("grid.npy", a) with a.dtype == np.float64
+///     auto mapped = hyper_array::mapped_array<const double, 3>::open_npy("grid.npy");
+/// @endcode
+/// @throw std::system_error if the file can't be written
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+void save_npy(const std::string& path, const array<ValueType, Dimensions, Order, Allocator>& arr)
+{
+    internal::saveDense<internal::npy_file_format>(path, arr.data(), internal::convertLengths<std::size_t>(arr.lengths()), Order);
+}
+
+/// Saves a view in NumPy's .npy format, @see save_npy()
+/// @note views that are dense in either order (e.g. a transposed array) are written as-is, others are copied first
+template <typename ValueType, std::size_t Dimensions, array_order Order>
+void save_npy(const std::string& path, const array_view<ValueType, Dimensions, Order>& view)
+{
+    internal::saveView<internal::npy_file_format>(path, view);
+}
+
+/// Loads a hyper array from a NumPy .npy file
+///
+/// The dtype must match `ValueType` (kind and size, e.g. `<f8` for double), and the shape must have `Dimensions` lengths.
+/// Elements stored in the other byte order are swapped, and C/Fortran order files are converted to `Order` if needed.
+/// @see mapped_array::open_npy() for accessing the elements without reading (or copying) them
+/// @throw std::system_error if the file can't be read
+/// @throw std::runtime_error if it isn't a .npy file of `Dimensions` `ValueType` elements
+template <
+    typename    ValueType,
+    std::size_t Dimensions,
+    array_order Order     = array_order::ROW_MAJOR,
+    typename    Allocator = std::allocator<ValueType>
+>
+array<ValueType, Dimensions, Order, Allocator> load_npy(const std::string& path)
+{
+    return internal::loadFile<internal::npy_file_format, ValueType, Dimensions, Order, Allocator>(path);
+}
+
+#if HYPER_ARRAY_MEMORY_MAPPING
+/// how a hyper_array::mapped_array maps its file
+enum class map_mode : int
+{
+    read_only,      ///< the elements can't be modified
+    copy_on_write,  ///< modifications are private to the process (modified pages are copied), the file is never written
+    read_write      ///< modifications are written to the file (and visible to other processes mapping it)
+};
+
+/// access pattern hints, cf. mapped_array::advise()
+enum class map_advice : int
+{
+    normal,      ///< default read-ahead
+    sequential,  ///< aggressive read-ahead, pages can be released soon after being read
+    random,      ///< no read-ahead
+    will_need    ///< start reading the whole mapping in the background
+};
+
+/// A hyper array that is stored in a memory-mapped file
+///
+/// Opening (or creating) a file only maps it: the elements are read (and written) by the page cache
+/// as they are accessed, i.e. files that are much larger than the RAM can be used,
+/// and they don't need to be loaded before being used.
+/// The lengths and the order are persisted in the file's header (cf. the "File Storage" section),
+/// the elements follow the header.
+///
+/// `ValueType` can be `const`-qualified in order to open files in read-only mode.
+/// Element access and iteration follow the semantics of hyper_array::array_view (cf. view()).
+///
+/// Usage:
+/// @code
+///     // 1024^3 floats (4 GiB), allocated lazily by the file system
+///     auto volume = hyper_array::mapped_array<float, 3>::create("volume.ha", 1024, 1024, 1024);
+///     volume(1, 2, 3) = 4.0f;
+///     volume.flush();
+///
+///     const auto readOnly = hyper_array::mapped_array<const float, 3>::open("volume.ha");
+///     auto scratch        = hyper_array::mapped_array<float, 3>::open("volume.ha", hyper_array::map_mode::copy_on_write);
+/// @endcode
+/// @note POSIX only (cf. HYPER_ARRAY_CONFIG_Memory_Mapping)
+template <
+    typename    ValueType,                          ///< elements' type, must be trivial
+    std::size_t Dimensions,                         ///< number of dimensions
+    array_order Order = array_order::ROW_MAJOR      ///< iteration order of the view (the file's order defines the layout)
+>
+class mapped_array
+{
+    static_assert(std::is_trivial<typename std::remove_const<ValueType>::type>::value,
+                  "the elements of a hyper_array::mapped_array must be trivial");
+
+public:
+
+    // <editor-fold defaultstate="collapsed" desc="STL-like types">
+    using value_type      = typename std::remove_const<ValueType>::type;
+    using element_type    = ValueType;
+    using pointer         = element_type*;
+    using reference       = element_type&;
+    using size_type       = std::size_t;
+    using view_type       = array_view<element_type, Dimensions, Order>;
+    using iterator        = typename view_type::iterator;
+    // </editor-fold>
+
+private:
+
+    // <editor-fold desc="Class Attributes">
+    /// beginning of the mapping, i.e. of the file's header
+    void* _mapping;
+
+    /// size of the mapping in bytes, i.e. the size of the file
+    std::size_t _mappingSize;
+
+    map_mode _mode;
+
+    /// the elements, located after the header
+    view_type _view;
+
+    /// the mapped file, for the error messages
+    std::string _path;
+    // </editor-fold>
+
+public:
+
+    // <editor-fold defaultstate="collapsed" desc="Constructors">
+    /// Creates (or truncates) a file that stores an array of `lengths`, and maps it in read-write mode
+    /// @note the elements are zero (the file is extended without writing anything, i.e. it is sparse if possible)
+    /// @throw std::system_error if the file can't be created or mapped
+    static mapped_array create(const std::string& path, const ::std::array<size_type, Dimensions>& lengths)
+    {
+        static_assert(!std::is_const<element_type>::value, "cannot create a read-only hyper_array::mapped_array");
+
+        const std::size_t dataOffset = internal::fileDataOffset<Dimensions>();
+        const std::size_t dataSize   = internal::fileDataSize<value_type>(lengths);
+        if (dataSize > static_cast<std::size_t>(std::numeric_limits<off_t>::max()) - dataOffset)
+        {
+            throw std::length_error("hyper_array::mapped_array: the file size overflows off_t");
+        }
+
+        const file_descriptor fd{path, ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)};
+        if (::ftruncate(fd.fd, static_cast<off_t>(dataOffset + dataSize)) != 0)
+        {
+            internal::fileSystemError("ftruncate", path);
+        }
+        void* const mapping = map(fd.fd, dataOffset + dataSize, map_mode::read_write, path);
+        internal::encodeFileHeader<value_type>(static_cast<unsigned char*>(mapping), lengths, Order);
+
+        return {mapping, dataOffset + dataSize, map_mode::read_write,
+                view_type{reinterpret_cast<pointer>(static_cast<unsigned char*>(mapping) + dataOffset),
+                          lengths, internal::denseStrides(lengths, Order)},
+                path};
+    }
+
+    /// variadic version of create()
+    template <
+        typename... DimensionLengths,
+        typename = internal::enable_if_t<
+            (sizeof...(DimensionLengths) == Dimensions) && internal::are_integral<DimensionLengths...>::value,
+            void>
+    >
+    static mapped_array create(const std::string& path, DimensionLengths... dimensionLengths)
+    {
+        return create(path, ::std::array<size_type, Dimensions>{{static_cast<size_type>(dimensionLengths)...}});
+    }
+
+    /// Maps an existing file
+    /// @note the file can be in either order: the view's strides follow the file's order
+    /// @throw std::system_error if the file can't be opened or mapped
+    /// @throw std::runtime_error if it isn't a hyper_array file of `Dimensions` `value_type` elements
+    static mapped_array open(const std::string& path,
+                             const map_mode mode = std::is_const<element_type>::value ? map_mode::read_only : map_mode::read_write)
+    {
+        return openAs<internal::native_file_format>(path, mode);
+    }
+
+    /// Maps an existing NumPy .npy file, @see load_npy()
+    /// @note the elements must be in the native byte order
+    /// @throw std::system_error if the file can't be opened or mapped
+    /// @throw std::runtime_error if it isn't a .npy file of `Dimensions` `value_type` elements
+    static mapped_array open_npy(const std::string& path,
+                                 const map_mode mode = std::is_const<element_type>::value ? map_mode::read_only : map_mode::read_write)
+    {
+        return openAs<internal::npy_file_format>(path, mode);
+    }
+
+    mapped_array(const mapped_array&) = delete;
+
+    mapped_array(mapped_array&& other) noexcept
+    : _mapping    (other._mapping)
+    , _mappingSize(other._mappingSize)
+    , _mode       (other._mode)
+    , _view       (other._view)
+    , _path       (std::move(other._path))
+    {
+        other._mapping     = nullptr;
+        other._mappingSize = 0;
+    }
+
+    mapped_array& operator=(const mapped_array&) = delete;
+
+    mapped_array& operator=(mapped_array&& other) noexcept
+    {
+        if (this != &other)
+        {
+            unmap();
+            _mapping           = other._mapping;
+            _mappingSize       = other._mappingSize;
+            _mode              = other._mode;
+            _view              = other._view;
+            _path              = std::move(other._path);
+            other._mapping     = nullptr;
+            other._mappingSize = 0;
+        }
+        return *this;
+    }
+
+    /// unmaps the file
+    /// @note in read-write mode, the modifications are written back by the system eventually, cf. flush()
+    ~mapped_array()
+    {
+        unmap();
+    }
+    // </editor-fold>
+
+    // <editor-fold defaultstate="collapsed" desc="Whole-Array Iterators">
+    iterator begin() const noexcept { return _view.begin(); }
+    iterator end()   const noexcept { return _view.end();   }
+    // </editor-fold>
+
+    // <editor-fold defaultstate="collapsed" desc="Template Arguments">
+    /// number of dimensions
+    static constexpr size_type   dimensions() noexcept { return Dimensions; }
+    /// the convention used for iterating over the elements
+    static constexpr array_order order()      noexcept { return Order;      }
+    // </editor-fold>
+
+    /// how the file is mapped
+    map_mode mode() const noexcept
+    {
+        return _mode;
+    }
+
+    /// Returns a view over the elements
+    const view_type& view() const noexcept
+    {
+        return _view;
+    }
+
+    /// Returns the length of a given dimension at run-time
+    size_type length(const size_type dimensionIndex) const
+    {
+        return _view.length(dimensionIndex);
+    }
+
+    /// Returns a reference to the lengths array
+    const ::std::array<size_type, Dimensions>& lengths() const noexcept
+    {
+        return _view.lengths();
+    }
+
+    /// Returns the total number of elements
+    size_type size() const noexcept
+    {
+        return _view.size();
+    }
+
+    /// Returns a pointer to the element at index (0, 0, ..., 0)
+    pointer data() const noexcept
+    {
+        return _view.data();
+    }
+
+    /// Returns the element at the given index tuple
+    /// @see array_view::at()
+    template <typename... Indices>
+    auto at(Indices... indices) const
+    -> decltype(std::declval<const view_type&>().at(indices...))
+    {
+        return _view.at(indices...);
+    }
+
+    /// Unchecked version of at()
+    template <typename... Indices>
+    auto operator()(Indices... indices) const
+    -> decltype(std::declval<const view_type&>()(indices...))
+    {
+        return _view(indices...);
+    }
+
+    /// Writes the modifications back to the file, synchronously
+    /// @note no-op unless the mode is map_mode::read_write
+    /// @throw std::system_error if msync() fails
+    void flush() const
+    {
+        if ((_mode == map_mode::read_write) && (_mapping != nullptr) && (::msync(_mapping, _mappingSize, MS_SYNC) != 0))
+        {
+            internal::fileSystemError("msync", _path);
+        }
+    }
+
+    /// Tells the system how the elements are going to be accessed, e.g. in order to tune the read-ahead
+    /// @note this is only a hint, errors are ignored
+    void advise(const map_advice advice) const noexcept
+    {
+        static const int advices[] = {MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED};
+        if (_mapping != nullptr)
+        {
+            ::madvise(_mapping, _mappingSize, advices[static_cast<int>(advice)]);
+        }
+    }
+
+private:
+
+    /// closes the file once mapped (the mapping remains valid)
+    struct file_descriptor
+    {
+        int fd;
+
+        file_descriptor(const std::string& path, const int fd_)
+        : fd(fd_)
+        {
+            if (fd < 0)
+            {
+                internal::fileSystemError("open", path);
+            }
+        }
+
+        file_descriptor(const file_descriptor&) = delete;
+        file_descriptor& operator=(const file_descriptor&) = delete;
+
+        ~file_descriptor()
+        {
+            ::close(fd);
+        }
+    };
+
+    mapped_array(void* mapping, const std::size_t mappingSize, const map_mode mode, const view_type& view, const std::string& path)
+    : _mapping    (mapping)
+    , _mappingSize(mappingSize)
+    , _mode       (mode)
+    , _view       (view)
+    , _path       (path)
+    {}
+
+    /// maps an existing file, whose header is decoded by `Format`
+    template <typename Format>
+    static mapped_array openAs(const std::string& path, const map_mode mode)
+    {
+        if (!std::is_const<element_type>::value && (mode == map_mode::read_only))
+        {
+            throw std::invalid_argument("hyper_array::mapped_array: read-only mappings require a const value type");
+        }
+
+        const file_descriptor fd{path, ::open(path.c_str(), (mode == map_mode::read_write) ? O_RDWR : O_RDONLY)};
+        struct stat status;
+        if (::fstat(fd.fd, &status) != 0)
+        {
+            internal::fileSystemError("fstat", path);
+        }
+        const std::size_t fileSize = static_cast<std::size_t>(status.st_size);
+        if (fileSize == 0)
+        {
+            internal::fileFormatError(path, "the file is empty");
+        }
+
+        void* const mapping = map(fd.fd, fileSize, mode, path);
+        try
+        {
+            const auto info = Format::template decode<value_type, Dimensions>(static_cast<const unsigned char*>(mapping), fileSize, path);
+            if ((info.dataOffset > fileSize) || (info.dataSize > fileSize - info.dataOffset))
+            {
+                internal::fileFormatError(path, "the file is truncated");
+            }
+            if (info.byteSwapped || (info.dataOffset % alignof(value_type) != 0))
+            {
+                internal::fileFormatError(path, info.byteSwapped ? "cannot map elements that are in the other byte order"
+                                                                 : "cannot map misaligned elements");
+            }
+            return {mapping, fileSize, mode,
+                    view_type{reinterpret_cast<pointer>(static_cast<unsigned char*>(mapping) + info.dataOffset),
+                              info.lengths, internal::denseStrides(info.lengths, info.order)},
+                    path};
+        }
+        catch (...)
+        {
+            ::munmap(mapping, fileSize);
+            throw;
+        }
+    }
+
+    static void* map(const int fd, const std::size_t size, const map_mode mode, const std::string& path)
+    {
+        const int protection = (mode == map_mode::read_only) ? PROT_READ : (PROT_READ | PROT_WRITE);
+        const int flags      = (mode == map_mode::copy_on_write) ? MAP_PRIVATE : MAP_SHARED;
+        void* const mapping  = ::mmap(nullptr, size, protection, flags, fd, 0);
+        if (mapping == MAP_FAILED)
+        {
+            internal::fileSystemError("mmap", path);
+        }
+        return mapping;
+    }
+
+    void unmap() noexcept
+    {
+        if (_mapping != nullptr)
+        {
+            ::munmap(_mapping, _mappingSize);
+        }
+    }
+};
+#endif
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Hyperslab Streaming">
+/// A box of elements of a `Dimensions`-dimensional array: the indices `[offsets[i], offsets[i] + lengths[i])` of each dimension `i`
+template <std::size_t Dimensions>
+struct hyperslab
+{
+    ::std::array<std::size_t, Dimensions> offsets;
+    ::std::array<std::size_t, Dimensions> lengths;
+
+    /// number of elements
+    std::size_t size() const noexcept
+    {
+        std::size_t result = 1;
+        for (const std::size_t length : lengths)
+        {
+            result *= length;
+        }
+        return result;
+    }
+};
+
+/// Splits an array of `lengths` into tiles of (at most) `tileLengths`, in the order of the tiles' grid
+/// i.e. the tiles of the last dimension come first with ROW_MAJOR, those of the first dimension with COLUMN_MAJOR.
+/// The tiles at the end of each dimension are truncated to fit within the array.
+///
+/// Usage:
+/// @code
+///     // {T, H, W} dataset processed 16 frames at a time
+///     const auto slabs = hyper_array::tile_hyperslabs(file.lengths(), {{16, H, W}});
+/// @endcode
+template <array_order Order = array_order::ROW_MAJOR, std::size_t Dimensions>
+std::vector<hyperslab<Dimensions>> tile_hyperslabs(const ::std::array<std::size_t, Dimensions>& lengths,
+                                                   const ::std::array<std::size_t, Dimensions>& tileLengths)
+{
+    ::std::array<std::size_t, Dimensions> tiles;
+    std::size_t                           count = 1;
+    for (std::size_t i = 0; i < Dimensions; ++i)
+    {
+        assert(tileLengths[i] > 0);
+        tiles[i] = (lengths[i] + tileLengths[i] - 1) / tileLengths[i];
+        count   *= tiles[i];
+    }
+
+    std::vector<hyperslab<Dimensions>>    result(count);
+    ::std::array<std::size_t, Dimensions> tile{};
+    for (hyperslab<Dimensions>& slab : result)
+    {
+        for (std::size_t i = 0; i < Dimensions; ++i)
+        {
+            slab.offsets[i] = tile[i] * tileLengths[i];
+            slab.lengths[i] = (lengths[i] - slab.offsets[i] < tileLengths[i]) ? lengths[i] - slab.offsets[i] : tileLengths[i];
+        }
+        for (std::size_t rank = 0; rank < Dimensions; ++rank)
+        {
+            const std::size_t dim = internal::dimensionByRank<Order, Dimensions>(rank);
+            if (++tile[dim] < tiles[dim])
+            {
+                break;
+            }
+            tile[dim] = 0;
+        }
+    }
+    return result;
+}
+
+/// A hyper array that is stored in a file, and accessed by hyperslabs
+///
+/// Unlike hyper_array::load(), opening a file only reads its header: read() and write() transfer arbitrary hyperslabs
+/// between the file and hyper arrays (or views) in memory, i.e. the memory usage is bounded by the hyperslabs,
+/// not by the file. Each transfer is done in as few bulk I/Os as possible, e.g. a single one for a slab of whole frames.
+/// hyperslab_reader and hyperslab_writer stream sequences of hyperslabs on a background thread.
+///
+/// `ValueType` can be `const`-qualified in order to open files in read-only mode.
+/// The file's order defines its layout, `Order` is the order of the arrays that are transferred.
+/// Transfers are serialized, i.e. an array_file can be shared by several threads.
+///
+/// Usage:
+/// @code
+///     auto input = hyper_array::array_file<const float, 3>::open("frames.ha");   // {T, H, W}
+///     hyper_array::array<float, 3> frames{16, input.length(1), input.length(2)};
+///     input.read({{32, 0, 0}, frames.lengths()}, frames);                         // frames [32, 48)
+/// @endcode
+/// @see hyper_array::save() for the file format, hyper_array::mapped_array for memory-mapped access
+template <
+    typename    ValueType,                          ///< elements' type, must be trivial
+    std::size_t Dimensions,                         ///< number of dimensions
+    array_order Order = array_order::ROW_MAJOR      ///< order of the arrays and views that are read or written
+>
+class array_file
+{
+    static_assert(std::is_trivial<typename std::remove_const<ValueType>::type>::value,
+                  "the elements of a hyper_array::array_file must be trivial");
+
+public:
+
+    // <editor-fold defaultstate="collapsed" desc="STL-like types">
+    using value_type      = typename std::remove_const<ValueType>::type;
+    using element_type    = ValueType;
+    using size_type       = std::size_t;
+    using slab_type       = hyperslab<Dimensions>;
+    using view_type       = array_view<value_type, Dimensions, Order>;
+    using const_view_type = array_view<const value_type, Dimensions, Order>;
+    // </editor-fold>
+
+private:
+
+    // <editor-fold desc="Class Attributes">
+    std::string                     _path;
+    internal::file_ptr              _file;
+    internal::file_info<Dimensions> _info;
+
+    /// serializes the transfers, which move the file's position
+    std::unique_ptr<std::mutex> _mutex;
+    // </editor-fold>
+
+public:
+
+    // <editor-fold defaultstate="collapsed" desc="Constructors">
+    /// Creates (or truncates) a file that stores an array of `lengths`, in `Order`
+    /// @note the elements are zero (the file is extended without writing them, i.e. it is sparse if possible)
+    /// @throw std::system_error if the file can't be created
+    static array_file create(const std::string& path, const ::std::array<size_type, Dimensions>& lengths)
+    {
+        static_assert(!std::is_const<element_type>::value, "cannot create a read-only hyper_array::array_file");
+
+        const std::size_t dataOffset = internal::fileDataOffset<Dimensions>();
+        const std::size_t dataSize   = internal::fileDataSize<value_type>(lengths);
+        if (dataSize > std::numeric_limits<std::size_t>::max() - dataOffset)
+        {
+            throw std::length_error("hyper_array::array_file: the file size overflows std::size_t");
+        }
+
+        internal::file_ptr file = internal::openFile(path, "w+b");
+        const auto header = internal::native_file_format::encode<value_type, Dimensions>(lengths, Order);
+        internal::writeFile(file.get(), header.data(), header.size(), path);
+        if (dataSize > 0)
+        {
+            const unsigned char zero = 0;
+            internal::seekFile(file.get(), dataOffset + dataSize - 1, path);
+            internal::writeFile(file.get(), &zero, 1, path);
+        }
+        return {path, std::move(file), {lengths, Order, dataOffset, dataSize, false}};
+    }
+
+    /// variadic version of create()
+    template <
+        typename... DimensionLengths,
+        typename = internal::enable_if_t<
+            (sizeof...(DimensionLengths) == Dimensions) && internal::are_integral<DimensionLengths...>::value,
+            void>
+    >
+    static array_file create(const std::string& path, DimensionLengths... dimensionLengths)
+    {
+        return create(path, ::std::array<size_type, Dimensions>{{static_cast<size_type>(dimensionLengths)...}});
+    }
+
+    /// Opens an existing file, in read-only mode if `ValueType` is `const`, in read-write mode otherwise
+    /// @note the file can be in either order
+    /// @throw std::system_error if the file can't be opened
+    /// @throw std::runtime_error if it isn't a hyper_array file of `Dimensions` `value_type` elements
+    static array_file open(const std::string& path)
+    {
+        return openAs<internal::native_file_format>(path);
+    }
+
+    /// Opens an existing NumPy .npy file, @see load_npy()
+    /// @note in read-write mode, the elements must be in the native byte order
+    /// @throw std::system_error if the file can't be opened
+    /// @throw std::runtime_error if it isn't a .npy file of `Dimensions` `value_type` elements
+    static array_file open_npy(const std::string& path)
+    {
+        return openAs<internal::npy_file_format>(path);
+    }
+    // </editor-fold>
+
+    // <editor-fold defaultstate="collapsed" desc="Template Arguments">
+    /// number of dimensions
+    static constexpr size_type   dimensions() noexcept { return Dimensions; }
+    /// the order of the arrays that are transferred
+    static constexpr array_order order()      noexcept { return Order;      }
+    // </editor-fold>
+
+    /// the order of the elements in the file
+    array_order file_order() const noexcept
+    {
+        return _info.order;
+    }
+
+    /// Returns the length of a given dimension at run-time
+    size_type length(const size_type dimensionIndex) const
+    {
+        return _info.lengths[dimensionIndex];
+    }
+
+    /// Returns a reference to the lengths array
+    const ::std::array<size_type, Dimensions>& lengths() const noexcept
+    {
+        return _info.lengths;
+    }
+
+    /// Returns the total number of elements
+    size_type size() const noexcept
+    {
+        return hyperslab<Dimensions>{{}, _info.lengths}.size();
+    }
+
+    /// Reads the elements of `slab` into `destination`, whose lengths must be those of the slab
+    /// @note `destination` can be any view, e.g. a transposed or strided one
+    /// @throw std::out_of_range if the slab isn't within the file's lengths
+    /// @throw std::system_error if the file can't be read, std::runtime_error if it is truncated
+    void read(const slab_type& slab, const view_type& destination) const
+    {
+        assert(destination.lengths() == slab.lengths);
+        checkSlab(slab);
+
+        const std::lock_guard<std::mutex> lock{*_mutex};
+        std::vector<value_type> staging;
+        forEachRun(slab, destination.coeffs(),
+                   [&](const std::size_t fileOffset, const std::ptrdiff_t offset, const std::size_t count, const std::ptrdiff_t stride)
+        {
+            value_type* const first = destination.data() + offset;
+            internal::seekFile(_file.get(), fileOffset, _path);
+            if (stride == 1)
+            {
+                internal::readFile(_file.get(), first, count * sizeof(value_type), _path);
+                swapIfNeeded(first, count);
+                return;
+            }
+            staging.resize(count);
+            internal::readFile(_file.get(), staging.data(), count * sizeof(value_type), _path);
+            swapIfNeeded(staging.data(), count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                first[static_cast<std::ptrdiff_t>(i) * stride] = staging[i];
+            }
+        });
+    }
+
+    /// Reads the elements of `slab` into `destination`
+    /// @see read(const slab_type&, const view_type&)
+    template <typename Allocator>
+    void read(const slab_type& slab, array<value_type, Dimensions, Order, Allocator>& destination) const
+    {
+        read(slab, destination.view());
+    }
+
+    /// Reads the elements of `slab` into a new array
+    /// @see read(const slab_type&, const view_type&)
+    array<value_type, Dimensions, Order> read(const slab_type& slab) const
+    {
+        array<value_type, Dimensions, Order> result{uninitialized, slab.lengths};
+        read(slab, result.view());
+        return result;
+    }
+
+    /// Writes `source`, whose lengths must be those of `slab`, to the elements of `slab`
+    /// @note `source` can be any view, e.g. a transposed or strided one
+    /// @throw std::out_of_range if the slab isn't within the file's lengths
+    /// @throw std::system_error if the file can't be written
+    void write(const slab_type& slab, const const_view_type& source)
+    {
+        static_assert(!std::is_const<element_type>::value, "cannot write to a read-only hyper_array::array_file");
+        assert(source.lengths() == slab.lengths);
+        checkSlab(slab);
+
+        const std::lock_guard<std::mutex> lock{*_mutex};
+        std::vector<value_type> staging;
+        forEachRun(slab, source.coeffs(),
+                   [&](const std::size_t fileOffset, const std::ptrdiff_t offset, const std::size_t count, const std::ptrdiff_t stride)
+        {
+            const value_type* first = source.data() + offset;
+            if (stride != 1)
+            {
+                staging.resize(count);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    staging[i] = first[static_cast<std::ptrdiff_t>(i) * stride];
+                }
+                first = staging.data();
+            }
+            internal::seekFile(_file.get(), fileOffset, _path);
+            internal::writeFile(_file.get(), first, count * sizeof(value_type), _path);
+        });
+    }
+
+    /// Writes `source` to the elements of `slab`
+    /// @see write(const slab_type&, const const_view_type&)
+    template <typename Allocator>
+    void write(const slab_type& slab, const array<value_type, Dimensions, Order, Allocator>& source)
+    {
+        write(slab, source.view());
+    }
+
+    /// Writes the buffered modifications to the file (i.e. std::fflush(), not a synchronization with the disk)
+    /// @throw std::system_error if fflush() fails
+    void flush()
+    {
+        const std::lock_guard<std::mutex> lock{*_mutex};
+        if (std::fflush(_file.get()) != 0)
+        {
+            internal::fileSystemError("fflush", _path);
+        }
+    }
+
+private:
+
+    array_file(const std::string& path, internal::file_ptr&& file, const internal::file_info<Dimensions>& info)
+    : _path (path)
+    , _file (std::move(file))
+    , _info (info)
+    , _mutex(new std::mutex)
+    {}
+
+    /// opens an existing file, whose header is decoded by `Format`
+    template <typename Format>
+    static array_file openAs(const std::string& path)
+    {
+        internal::file_ptr file = internal::openFile(path, std::is_const<element_type>::value ? "rb" : "r+b");
+        const auto         info = Format::template read<value_type, Dimensions>(file.get(), path);
+        if (info.byteSwapped && !std::is_const<element_type>::value)
+        {
+            internal::fileFormatError(path, "cannot write elements that are in the other byte order");
+        }
+        return {path, std::move(file), info};
+    }
+
+    void checkSlab(const slab_type& slab) const
+    {
+        for (std::size_t i = 0; i < Dimensions; ++i)
+        {
+            if ((slab.offsets[i] > _info.lengths[i]) || (slab.lengths[i] > _info.lengths[i] - slab.offsets[i]))
+            {
+                throw std::out_of_range("hyper_array::array_file: the hyperslab exceeds the lengths of " + _path);
+            }
+        }
+    }
+
+    void swapIfNeeded(value_type* data, const std::size_t count) const noexcept
+    {
+        if (_info.byteSwapped)
+        {
+            internal::swapBytes(data, count);
+        }
+    }
+
+    /// Calls `transfer(fileOffset, offset, count, stride)` for each run of the slab's elements that is contiguous
+    /// in the file: `fileOffset` in bytes from the beginning of the file, `offset` and `stride` in elements of the
+    /// memory view whose strides are `coeffs`.
+    /// The runs extend over several dimensions when the slab spans the whole length of the faster ones
+    /// and the memory view's elements are equally spaced along them, e.g. a single run for whole frames.
+    template <typename Transfer>
+    void forEachRun(const slab_type& slab, const ::std::array<std::ptrdiff_t, Dimensions>& coeffs, Transfer&& transfer) const
+    {
+        if (slab.size() == 0)
+        {
+            return;
+        }
+
+        const auto fileStrides = internal::denseStrides(_info.lengths, _info.order);
+        const auto dimension   = [this](const std::size_t rank)
+        {
+            return (_info.order == array_order::ROW_MAJOR) ? Dimensions - 1 - rank : rank;
+        };
+
+        // the run covers the dimensions of rank [0, runRanks) in the file's order
+        const std::ptrdiff_t stride   = coeffs[dimension(0)];
+        std::size_t          count    = slab.lengths[dimension(0)];
+        std::size_t          runRanks = 1;
+        while ((runRanks < Dimensions)
+               && (slab.lengths[dimension(runRanks - 1)] == _info.lengths[dimension(runRanks - 1)])
+               && (coeffs[dimension(runRanks)] == stride * static_cast<std::ptrdiff_t>(count)))
+        {
+            count *= slab.lengths[dimension(runRanks)];
+            ++runRanks;
+        }
+
+        ::std::array<std::size_t, Dimensions> indices{};
+        for (std::size_t run = 0, runs = slab.size() / count; run < runs; ++run)
+        {
+            std::size_t    fileOffset = 0;
+            std::ptrdiff_t offset     = 0;
+            for (std::size_t i = 0; i < Dimensions; ++i)
+            {
+                fileOffset += (slab.offsets[i] + indices[i]) * static_cast<std::size_t>(fileStrides[i]);
+                offset     += static_cast<std::ptrdiff_t>(indices[i]) * coeffs[i];
+            }
+            transfer(_info.dataOffset + fileOffset * sizeof(value_type), offset, count, stride);
+
+            for (std::size_t rank = runRanks; rank < Dimensions; ++rank)
+            {
+                const std::size_t dim = dimension(rank);
+                if (++indices[dim] < slab.lengths[dim])
+                {
+                    break;
+                }
+                indices[dim] = 0;
+            }
+        }
+    }
+};
+
+namespace internal
+{
+
+/// the buffers and the synchronization shared by hyperslab_reader and hyperslab_writer
+/// Slab `i` is transferred through buffer `i % depth`, by the background thread.
+template <typename ValueType, std::size_t Dimensions, array_order Order>
+class hyperslab_stream
+{
+public:
+
+    using slab_type = hyperslab<Dimensions>;
+    using view_type = array_view<ValueType, Dimensions, Order>;
+
+    hyperslab_stream(const hyperslab_stream&)            = delete;
+    hyperslab_stream& operator=(const hyperslab_stream&) = delete;
+
+    /// the current hyperslab
+    const slab_type& slab() const noexcept
+    {
+        return _slabs[_next - 1];
+    }
+
+    /// the elements of the current hyperslab
+    /// @note valid until the next call to next()
+    const view_type& view() const noexcept
+    {
+        return _view;
+    }
+
+    /// index of the current hyperslab in the sequence
+    std::size_t index() const noexcept
+    {
+        return _next - 1;
+    }
+
+protected:
+
+    hyperslab_stream(std::vector<slab_type>&& slabs, const std::size_t depth)
+    : _slabs(std::move(slabs))
+    , _view (nullptr, ::std::array<std::size_t, Dimensions>{}, ::std::array<std::ptrdiff_t, Dimensions>{})
+    {
+        if (depth == 0)
+        {
+            throw std::invalid_argument("hyper_array::hyperslab_stream: the depth must be at least 1");
+        }
+        std::size_t bufferSize = 0;
+        for (const slab_type& slab : _slabs)
+        {
+            bufferSize = (slab.size() > bufferSize) ? slab.size() : bufferSize;
+        }
+        const std::size_t buffers = (depth < _slabs.size()) ? depth : _slabs.size();
+        for (std::size_t i = 0; i < buffers; ++i)
+        {
+            _buffers.emplace_back(uninitialized, bufferSize);
+        }
+    }
+
+    /// dense view of the buffer of the `index`-th hyperslab
+    view_type bufferView(const std::size_t index)
+    {
+        const ::std::array<std::size_t, Dimensions>& lengths = _slabs[index].lengths;
+        return {_buffers[index % _buffers.size()].data(), lengths,
+                toStrides(computeIndexCoeffs<std::size_t, Dimensions, Order>(lengths))};
+    }
+
+    /// rethrows the exception of the background thread, if any
+    void rethrow()
+    {
+        if (_error)
+        {
+            std::rethrow_exception(_error);
+        }
+    }
+
+    const std::vector<slab_type>               _slabs;
+    std::vector<array<ValueType, 1>>           _buffers;
+    view_type                                  _view;
+    std::size_t                                _next = 0;      ///< number of hyperslabs handed out by next()
+    std::size_t                                _done = 0;      ///< number of hyperslabs transferred by the thread
+    bool                                       _stop = false;
+    std::exception_ptr                         _error;
+    std::mutex                                 _mutex;
+    std::condition_variable                    _changed;
+    std::thread                                _thread;
+};
+
+}
+
+/// Reads a sequence of hyperslabs of an array_file, with read-ahead on a background thread
+///
+/// The hyperslabs are read into `depth` preallocated buffers: while the current one is being processed,
+/// the next `depth - 1` ones are being read, i.e. processing overlaps with I/O
+/// and the memory usage is bounded by `depth` times the largest hyperslab.
+/// The elements of the current hyperslab can be modified, e.g. before writing them with a hyperslab_writer.
+///
+/// Usage:
+/// @code
+///     auto input = hyper_array::array_file<const float, 3>::open("frames.ha");
+///     hyper_array::hyperslab_reader<float, 3> reader{input, hyper_array::tile_hyperslabs(input.lengths(), {{16, H, W}})};
+///     while (reader.next())
+///     {
+///         process(reader.slab(), reader.view());
+///     }
+/// @endcode
+/// @note the file must outlive the reader
+template <
+    typename    ValueType,                          ///< elements' type
+    std::size_t Dimensions,                         ///< number of dimensions
+    array_order Order = array_order::ROW_MAJOR      ///< order of the views
+>
+class hyperslab_reader : public internal::hyperslab_stream<ValueType, Dimensions, Order>
+{
+    using base_type = internal::hyperslab_stream<ValueType, Dimensions, Order>;
+
+public:
+
+    using slab_type = typename base_type::slab_type;
+    using view_type = typename base_type::view_type;
+
+    /// starts reading `slabs` from `file`
+    /// @param depth  number of buffers, i.e. the current hyperslab and `depth - 1` read-ahead ones
+    /// @throw std::invalid_argument if `depth` is 0
+    template <typename FileValueType>
+    hyperslab_reader(const array_file<FileValueType, Dimensions, Order>& file, std::vector<slab_type> slabs, const std::size_t depth = 2)
+    : base_type(std::move(slabs), depth)
+    {
+        static_assert(std::is_same<typename std::remove_const<FileValueType>::type, ValueType>::value,
+                      "the reader's and the file's value types must match");
+        this->_thread = std::thread{&hyperslab_reader::readLoop<FileValueType>, this, &file};
+    }
+
+    /// stops reading, and waits for the background thread
+    ~hyperslab_reader()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{this->_mutex};
+            this->_stop = true;
+        }
+        this->_changed.notify_all();
+        this->_thread.join();
+    }
+
+    /// Moves to the next hyperslab, waiting for it to be read if necessary
+    /// @return false after the last one
+    /// @throw the exception that the background thread got while reading it, e.g. std::system_error
+    bool next()
+    {
+        std::unique_lock<std::mutex> lock{this->_mutex};
+        // releases the buffer of the current hyperslab
+        const std::size_t next = this->_next;
+        this->_next = (next < this->_slabs.size()) ? next + 1 : next;
+        this->_changed.notify_all();
+        if (next == this->_slabs.size())
+        {
+            return false;
+        }
+        this->_changed.wait(lock, [this, next] { return (this->_done > next) || this->_error; });
+        if (this->_done <= next)
+        {
+            this->_next = next;
+            this->rethrow();
+        }
+        this->_view = this->bufferView(next);
+        return true;
+    }
+
+private:
+
+    template <typename FileValueType>
+    void readLoop(const array_file<FileValueType, Dimensions, Order>* file)
+    {
+        const std::size_t depth = this->_buffers.size();
+        for (std::size_t i = 0; i < this->_slabs.size(); ++i)
+        {
+            {
+                // the buffer of the i-th hyperslab is free once the (i - depth)-th one is released
+                std::unique_lock<std::mutex> lock{this->_mutex};
+                this->_changed.wait(lock, [this, i, depth] { return (i + 1 < this->_next + depth) || this->_stop; });
+                if (this->_stop)
+                {
+                    return;
+                }
+            }
+            try
+            {
+                file->read(this->_slabs[i], this->bufferView(i));
+            }
+            catch (...)
+            {
+                const std::lock_guard<std::mutex> lock{this->_mutex};
+                this->_error = std::current_exception();
+                this->_changed.notify_all();
+                return;
+            }
+            {
+                const std::lock_guard<std::mutex> lock{this->_mutex};
+                this->_done = i + 1;
+            }
+            this->_changed.notify_all();
+        }
+    }
+};
+
+/// Writes a sequence of hyperslabs of an array_file, with write-behind on a background thread
+///
+/// next() returns a preallocated buffer for the next hyperslab: once it is filled, the following call to next()
+/// (or flush()) hands it over to the background thread, which writes it while the next one is being filled.
+/// The last hyperslab is only written by flush(): the destructor drops the current one, e.g. during stack unwinding.
+/// The memory usage is bounded by `depth` times the largest hyperslab.
+///
+/// Usage:
+/// @code
+///     auto output = hyper_array::array_file<float, 3>::create("result.ha", input.lengths());
+///     hyper_array::hyperslab_writer<float, 3> writer{output, slabs};
+///     while (reader.next() && writer.next())
+///     {
+///         hyper_array::evaluate(reader.view() * 2.0f, writer.view());
+///     }
+///     writer.flush();
+/// @endcode
+/// @note the file must outlive the writer
+template <
+    typename    ValueType,                          ///< elements' type
+    std::size_t Dimensions,                         ///< number of dimensions
+    array_order Order = array_order::ROW_MAJOR      ///< order of the views
+>
+class hyperslab_writer : public internal::hyperslab_stream<ValueType, Dimensions, Order>
+{
+    using base_type = internal::hyperslab_stream<ValueType, Dimensions, Order>;
+
+public:
+
+    using slab_type = typename base_type::slab_type;
+    using view_type = typename base_type::view_type;
+
+    /// prepares the buffers for writing `slabs` to `file`
+    /// @param depth  number of buffers, i.e. the current hyperslab and `depth - 1` ones being written
+    /// @throw std::invalid_argument if `depth` is 0
+    hyperslab_writer(array_file<ValueType, Dimensions, Order>& file, std::vector<slab_type> slabs, const std::size_t depth = 2)
+    : base_type(std::move(slabs), depth)
+    {
+        this->_thread = std::thread{&hyperslab_writer::writeLoop, this, &file};
+    }
+
+    /// finishes writing the hyperslabs that were handed over by next() or flush(), and waits for the background thread
+    /// @note the current hyperslab (i.e. the last one returned by next()) is NOT written, since it may not be filled
+    ///       e.g. when an exception interrupted the processing: call flush() after filling it
+    /// @note errors are ignored, cf. flush()
+    ~hyperslab_writer()
+    {
+        {
+            const std::lock_guard<std::mutex> lock{this->_mutex};
+            this->_stop = true;
+        }
+        this->_changed.notify_all();
+        this->_thread.join();
+    }
+
+    /// Hands the current hyperslab over to the background thread, and moves to the next one
+    /// i.e. waits until its buffer has been written, if necessary
+    /// @return false after the last one
+    /// @throw the exception that the background thread got while writing, e.g. std::system_error
+    bool next()
+    {
+        std::unique_lock<std::mutex> lock{this->_mutex};
+        _submitted = this->_next;
+        this->_changed.notify_all();
+        const std::size_t next  = this->_next;
+        const std::size_t depth = this->_buffers.size();
+        if (next == this->_slabs.size())
+        {
+            return false;
+        }
+        this->_changed.wait(lock, [this, next, depth] { return (next < this->_done + depth) || this->_error; });
+        this->rethrow();
+        this->_view = this->bufferView(next);
+        this->_next = next + 1;
+        return true;
+    }
+
+    /// Hands the current hyperslab over to the background thread, and waits until all the submitted ones are written
+    /// @throw the exception that the background thread got while writing, e.g. std::system_error
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock{this->_mutex};
+        _submitted = this->_next;
+        this->_changed.notify_all();
+        this->_changed.wait(lock, [this] { return (this->_done == _submitted) || this->_error; });
+        this->rethrow();
+    }
+
+private:
+
+    /// number of hyperslabs handed over to the background thread
+    std::size_t _submitted = 0;
+
+    void writeLoop(array_file<ValueType, Dimensions, Order>* file)
+    {
+        for (std::size_t i = 0; i < this->_slabs.size(); ++i)
+        {
+            {
+                std::unique_lock<std::mutex> lock{this->_mutex};
+                this->_changed.wait(lock, [this, i] { return (i < _submitted) || this->_stop; });
+                if (i >= _submitted)
+                {
+                    return;
+                }
+            }
+            try
+            {
+                file->write(this->_slabs[i], this->bufferView(i));
+            }
+            catch (...)
+            {
+                const std::lock_guard<std::mutex> lock{this->_mutex};
+                this->_error = std::current_exception();
+                this->_changed.notify_all();
+                return;
+            }
+            {
+                const std::lock_guard<std::mutex> lock{this->_mutex};
+                this->_done = i + 1;
+            }
+            this->_changed.notify_all();
+        }
+    }
+};
+// </editor-fold>
+
+// <editor-fold defaultstate="collapsed" desc="Text Formatting">
+/*
+ * Fast, locale-independent conversions between numbers and text, used by write_text(), read_text() and operator<<().
+ *
+ * Floating point numbers are formatted with the Grisu2 algorithm (cf. Florian Loitsch, "Printing Floating-Point
+ * Numbers Quickly and Accurately with Integers", PLDI 2010): the output is the shortest (or very nearly the shortest)
+ * decimal number that reads back as the exact same value, e.g. "0.1" rather than "0.10000000000000001".
+ * Parsing uses Clinger's fast path (cf. William D. Clinger, "How to Read Floating Point Numbers Accurately", PLDI 1990)
+ * when the decimal mantissa and the power of 10 are exactly representable (e.g. "0.25", "-1.5e+20"),
+ * and falls back to std::strtod() otherwise.
+ */
+namespace internal
+{
+
+/// "do it yourself" floating point number: f * 2^e
+struct diy_fp
+{
+    std::uint64_t f;
+    int           e;
+
+    static diy_fp sub(const diy_fp x, const diy_fp y) noexcept
+    {
+        return {x.f - y.f, x.e};
+    }
+
+    /// (x * y) / 2^64, rounded to nearest
+    static diy_fp mul(const diy_fp x, const diy_fp y) noexcept
+    {
+        const std::uint64_t xLo = x.f & 0xFFFFFFFFu, xHi = x.f >> 32;
+        const std::uint64_t yLo = y.f & 0xFFFFFFFFu, yHi = y.f >> 32;
+        const std::uint64_t lolo = xLo * yLo, lohi = xLo * yHi, hilo = xHi * yLo, hihi = xHi * yHi;
+        const std::uint64_t middle = (lolo >> 32) + (lohi & 0xFFFFFFFFu) + (hilo & 0xFFFFFFFFu) + (std::uint64_t{1} << 31);
+        return {hihi + (lohi >> 32) + (hilo >> 32) + (middle >> 32), x.e + y.e + 64};
+    }
+
+    static diy_fp normalize(diy_fp x) noexcept
+    {
+        while ((x.f >> 63) == 0)
+        {
+            x.f <<= 1;
+            --x.e;
+        }
+        return x;
+    }
+};
+
+/// a positive floating point value and the boundaries of its rounding interval, normalized
+struct fp_boundaries
+{
+    diy_fp w;
+    diy_fp minus;
+    diy_fp plus;
+};
+
+template <typename FloatType>
+fp_boundaries computeBoundaries(const FloatType value) noexcept
+{
+    using bits_type = typename std::conditional<sizeof(FloatType) == 4, std::uint32_t, std::uint64_t>::type;
+    static_assert(std::numeric_limits<FloatType>::is_iec559 && (sizeof(FloatType) == sizeof(bits_type)),
+                  "only IEEE 754 binary32 and binary64 numbers are supported");
+
+    constexpr int           precision = std::numeric_limits<FloatType>::digits;  // including the hidden bit
+    constexpr int           bias      = std::numeric_limits<FloatType>::max_exponent - 1 + (precision - 1);
+    constexpr std::uint64_t hiddenBit = std::uint64_t{1} << (precision - 1);
+
+    bits_type bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    const std::uint64_t fraction = bits & (hiddenBit - 1);
+    const int           exponent = static_cast<int>(bits >> (precision - 1));
+
+    const diy_fp v = (exponent == 0) ? diy_fp{fraction, 1 - bias}
+                                     : diy_fp{fraction + hiddenBit, exponent - bias};
+    // the lower boundary is closer for powers of 2 (except the smallest normal number)
+    const bool   lowerIsCloser = (fraction == 0) && (exponent > 1);
+    const diy_fp plus  = diy_fp::normalize({2 * v.f + 1, v.e - 1});
+    const diy_fp minus = lowerIsCloser ? diy_fp{4 * v.f - 1, v.e - 2} : diy_fp{2 * v.f - 1, v.e - 1};
+
+    return {diy_fp::normalize(v), {minus.f << (minus.e - plus.e), plus.e}, plus};
+}
+
+/// c = f * 2^e ~= 10^k
+struct cached_power
+{
+    std::uint64_t f;
+    int           e;
+    int           k;
+};
+
+/// returns c such that `alpha <= c.e + e + 64 <= gamma`, with `alpha == -60` and `gamma == -32`
+inline cached_power cachedPowerForBinaryExponent(const int e) noexcept
+{
+    // 10^-300, 10^-292, ..., 10^340 rounded to 64 bits
+    static const cached_power powers[] =
+    {
+    {0xAB70FE17C79AC6CA, -1060, -300},
+    {0xFF77B1FCBEBCDC4F, -1034, -292},
+    {0xBE5691EF416BD60C, -1007, -284},
+    {0x8DD01FAD907FFC3C,  -980, -276},
+    {0xD3515C2831559A83,  -954, -268},
+    {0x9D71AC8FADA6C9B5,  -927, -260},
+    {0xEA9C227723EE8BCB,  -901, -252},
+    {0xAECC49914078536D,  -874, -244},
+    {0x823C12795DB6CE57,  -847, -236},
+    {0xC21094364DFB5637,  -821, -228},
+    {0x9096EA6F3848984F,  -794, -220},
+    {0xD77485CB25823AC7,  -768, -212},
+    {0xA086CFCD97BF97F4,  -741, -204},
+    {0xEF340A98172AACE5,  -715, -196},
+    {0xB23867FB2A35B28E,  -688, -188},
+    {0x84C8D4DFD2C63F3B,  -661, -180},
+    {0xC5DD44271AD3CDBA,  -635, -172},
+    {0x936B9FCEBB25C996,  -608, -164},
+    {0xDBAC6C247D62A584,  -582, -156},
+    {0xA3AB66580D5FDAF6,  -555, -148},
+    {0xF3E2F893DEC3F126,  -529, -140},
+    {0xB5B5ADA8AAFF80B8,  -502, -132},
+    {0x87625F056C7C4A8B,  -475, -124},
+    {0xC9BCFF6034C13053,  -449, -116},
+    {0x964E858C91BA2655,  -422, -108},
+    {0xDFF9772470297EBD,  -396, -100},
+    {0xA6DFBD9FB8E5B88F,  -369,  -92},
+    {0xF8A95FCF88747D94,  -343,  -84},
+    {0xB94470938FA89BCF,  -316,  -76},
+    {0x8A08F0F8BF0F156B,  -289,  -68},
+    {0xCDB02555653131B6,  -263,  -60},
+    {0x993FE2C6D07B7FAC,  -236,  -52},
+    {0xE45C10C42A2B3B06,  -210,  -44},
+    {0xAA242499697392D3,  -183,  -36},
+    {0xFD87B5F28300CA0E,  -157,  -28},
+    {0xBCE5086492111AEB,  -130,  -20},
+    {0x8CBCCC096F5088CC,  -103,  -12},
+    {0xD1B71758E219652C,   -77,   -4},
+    {0x9C40000000000000,   -50,    4},
+    {0xE8D4A51000000000,   -24,   12},
+    {0xAD78EBC5AC620000,     3,   20},
+    {0x813F3978F8940984,    30,   28},
+    {0xC097CE7BC90715B3,    56,   36},
+    {0x8F7E32CE7BEA5C70,    83,   44},
+    {0xD5D238A4ABE98068,   109,   52},
+    {0x9F4F2726179A2245,   136,   60},
+    {0xED63A231D4C4FB27,   162,   68},
+    {0xB0DE65388CC8ADA8,   189,   76},
+    {0x83C7088E1AAB65DB,   216,   84},
+    {0xC45D1DF942711D9A,   242,   92},
+    {0x924D692CA61BE758,   269,  100},
+    {0xDA01EE641A708DEA,   295,  108},
+    {0xA26DA3999AEF774A,   322,  116},
+    {0xF209787BB47D6B85,   348,  124},
+    {0xB454E4A179DD1877,   375,  132},
+    {0x865B86925B9BC5C2,   402,  140},
+    {0xC83553C5C8965D3D,   428,  148},
+    {0x952AB45CFA97A0B3,   455,  156},
+    {0xDE469FBD99A05FE3,   481,  164},
+    {0xA59BC234DB398C25,   508,  172},
+    {0xF6C69A72A3989F5C,   534,  180},
+    {0xB7DCBF5354E9BECE,   561,  188},
+    {0x88FCF317F22241E2,   588,  196},
+    {0xCC20CE9BD35C78A5,   614,  204},
+    {0x98165AF37B2153DF,   641,  212},
+    {0xE2A0B5DC971F303A,   667,  220},
+    {0xA8D9D1535CE3B396,   694,  228},
+    {0xFB9B7CD9A4A7443C,   720,  236},
+    {0xBB764C4CA7A44410,   747,  244},
+    {0x8BAB8EEFB6409C1A,   774,  252},
+    {0xD01FEF10A657842C,   800,  260},
+    {0x9B10A4E5E9913129,   827,  268},
+    {0xE7109BFBA19C0C9D,   853,  276},
+    {0xAC2820D9623BF429,   880,  284},
+    {0x80444B5E7AA7CF85,   907,  292},
+    {0xBF21E44003ACDD2D,   933,  300},
+    {0x8E679C2F5E44FF8F,   960,  308},
+    {0xD433179D9C8CB841,   986,  316},
+    {0x9E19DB92B4E31BA9,  1013,  324},
+    {0xEB96BF6EBADF77D9,  1039,  332},
+    {0xAF87023B9BF0EE6B,  1066,  340}
+    };
+
+    constexpr int minDecimalExponent = -300;
+    constexpr int decimalStep        = 8;
+
+    // k = ceil((alpha - e - 1) * log10(2)), 78913 / 2^18 ~= log10(2)
+    const int f     = -60 - e - 1;
+    const int k     = (f * 78913) / (1 << 18) + static_cast<int>(f > 0);
+    const int index = (-minDecimalExponent + k + (decimalStep - 1)) / decimalStep;
+    return powers[index];
+}
+
+/// number of decimal digits of `n`, and the largest power of 10 that is <= n
+inline int largestPowerOf10(const std::uint32_t n, std::uint32_t& power) noexcept
+{
+    int digits = 10;
+    power      = 1000000000;
+    while ((digits > 1) && (n < power))
+    {
+        power /= 10;
+        --digits;
+    }
+    return digits;
+}
+
+/// moves the last digit of `buffer` closer to the exact value, within the rounding interval
+inline void grisuRound(char* buffer, const int length, const std::uint64_t distance, const std::uint64_t delta,
+                       std::uint64_t rest, const std::uint64_t tenK) noexcept
+{
+    while ((rest < distance) && (delta - rest >= tenK)
+           && ((rest + tenK < distance) || (distance - rest > rest + tenK - distance)))
+    {
+        --buffer[length - 1];
+        rest += tenK;
+    }
+}
+
+/// generates the digits of w, such that M- < digits * 10^exponent < M+
+inline void grisuDigits(char* buffer, int& length, int& exponent, const diy_fp minus, const diy_fp w, const diy_fp plus) noexcept
+{
+    std::uint64_t       delta    = diy_fp::sub(plus, minus).f;
+    std::uint64_t       distance = diy_fp::sub(plus, w).f;
+    const diy_fp        one{std::uint64_t{1} << -plus.e, plus.e};
+    std::uint32_t       integral = static_cast<std::uint32_t>(plus.f >> -one.e);
+    std::uint64_t       fractional = plus.f & (one.f - 1);
+
+    std::uint32_t power;
+    int           n = largestPowerOf10(integral, power);
+    while (n > 0)
+    {
+        buffer[length++] = static_cast<char>('0' + integral / power);
+        integral %= power;
+        --n;
+        const std::uint64_t rest = (std::uint64_t{integral} << -one.e) + fractional;
+        if (rest <= delta)
+        {
+            exponent += n;
+            grisuRound(buffer, length, distance, delta, rest, std::uint64_t{power} << -one.e);
+            return;
+        }
+        power /= 10;
+    }
+
+    int m = 0;
+    for (;;)
+    {
+        fractional *= 10;
+        buffer[length++] = static_cast<char>('0' + (fractional >> -one.e));
+        fractional &= one.f - 1;
+        ++m;
+        delta    *= 10;
+        distance *= 10;
+        if (fractional <= delta)
+        {
+            break;
+        }
+    }
+    exponent -= m;
+    grisuRound(buffer, length, distance, delta, fractional, one.f);
+}
+
+/// writes the digits of the shortest representation of `value` (> 0) such that value == digits * 10^exponent
+template <typename FloatType>
+void grisu2(char* buffer, int& length, int& exponent, const FloatType value) noexcept
+{
+    const fp_boundaries b      = computeBoundaries(value);
+    const cached_power  cached = cachedPowerForBinaryExponent(b.plus.e);
+    const diy_fp        c{cached.f, cached.e};
+
+    const diy_fp w     = diy_fp::mul(b.w,     c);
+    const diy_fp minus = diy_fp::mul(b.minus, c);
+    const diy_fp plus  = diy_fp::mul(b.plus,  c);
+
+    length   = 0;
+    exponent = -cached.k;
+    grisuDigits(buffer, length, exponent, {minus.f + 1, minus.e}, w, {plus.f - 1, plus.e});
+}
+
+/// writes an unsigned integer, returns the end of the written characters
+inline char* formatUnsigned(char* out, std::uint64_t value) noexcept
+{
+    char  digits[20];
+    char* p = digits + sizeof(digits);
+    do
+    {
+        *--p   = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value != 0);
+    const std::size_t count = static_cast<std::size_t>(digits + sizeof(digits) - p);
+    std::memcpy(out, p, count);
+    return out + count;
+}
+
+/// writes `digits` * 10^`exponent`, in fixed notation if the number is "reasonable", in scientific notation otherwise
+/// e.g. "12300", "1.23", "0.000123", "1.23e+20", "1.23e-07" (i.e. similar to printf's "%g", with all the digits)
+inline char* formatDecimal(char* out, const char* digits, const int length, const int exponent) noexcept
+{
+    const int point = length + exponent;  // position of the decimal point from the first digit
+
+    if ((length <= point) && (point <= 17))
+    {
+        // 12300
+        std::memcpy(out, digits, static_cast<std::size_t>(length));
+        std::memset(out + length, '0', static_cast<std::size_t>(point - length));
+        return out + point;
+    }
+    if ((0 < point) && (point <= 17))
+    {
+        // 1.23
+        std::memcpy(out, digits, static_cast<std::size_t>(point));
+        out[point] = '.';
+        std::memcpy(out + point + 1, digits + point, static_cast<std::size_t>(length - point));
+        return out + length + 1;
+    }
+    if ((-4 < point) && (point <= 0))
+    {
+        // 0.00123
+        out[0] = '0';
+        out[1] = '.';
+        std::memset(out + 2, '0', static_cast<std::size_t>(-point));
+        std::memcpy(out + 2 - point, digits, static_cast<std::size_t>(length));
+        return out + 2 - point + length;
+    }
+
+    // 1.23e+20
+    *out++ = digits[0];
+    if (length > 1)
+    {
+        *out++ = '.';
+        std::memcpy(out, digits + 1, static_cast<std::size_t>(length - 1));
+        out += length - 1;
+    }
+    const int e = point - 1;
+    *out++ = 'e';
+    *out++ = (e < 0) ? '-' : '+';
+    const unsigned absE = static_cast<unsigned>((e < 0) ? -e : e);
+    if (absE < 10)
+    {
+        *out++ = '0';
+    }
+    return formatUnsigned(out, absE);
+}
+
+/// writes a number in at most 32 characters, returns the end of the written characters
+template <typename T>
+enable_if_t<std::is_floating_point<T>::value, char*>
+formatNumber(char* out, const T value) noexcept
+{
+    static_assert(sizeof(T) <= 8, "long double is not supported");
+
+    if (value != value)
+    {
+        std::memcpy(out, "nan", 3);
+        return out + 3;
+    }
+    if (std::signbit(value))
+    {
+        *out++ = '-';
+    }
+    if ((value == std::numeric_limits<T>::infinity()) || (value == -std::numeric_limits<T>::infinity()))
+    {
+        std::memcpy(out, "inf", 3);
+        return out + 3;
+    }
+    if (value == 0)
+    {
+        *out = '0';
+        return out + 1;
+    }
+
+    char digits[20];
+    int  length;
+    int  exponent;
+    grisu2(digits, length, exponent, std::abs(value));
+    return formatDecimal(out, digits, length, exponent);
+}
+
+template <typename T>
+enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value, char*>
+formatNumber(char* out, const T value) noexcept
+{
+    if (value < 0)
+    {
+        *out++ = '-';
+        // -(value + 1) + 1 avoids overflowing with the minimum value
+        return formatUnsigned(out, static_cast<std::uint64_t>(-(value + 1)) + 1);
+    }
+    return formatUnsigned(out, static_cast<std::uint64_t>(value));
+}
+
+template <typename T>
+enable_if_t<std::is_integral<T>::value && std::is_unsigned<T>::value, char*>
+formatNumber(char* out, const T value) noexcept
+{
+    return formatUnsigned(out, static_cast<std::uint64_t>(value));
+}
+
+/// the element types that formatNumber() and parseNumber() support
+template <typename T>
+using is_text_number = std::integral_constant<
+    bool,
+    std::is_integral<T>::value || std::is_same<T, float>::value || std::is_same<T, double>::value>;
+
+/// buffers the characters written to a stream, which are written in large blocks using `std::ostream::write()`
+/// (i.e. without any formatting, nor locale)
+/// @note call flush() after the last character: the destructor writes what is left, but ignores the errors
+class text_writer
+{
+public:
+
+    explicit text_writer(std::ostream& out) noexcept
+    : _out (out)
+    , _used(0)
+    {}
+
+    text_writer(const text_writer&) = delete;
+    text_writer& operator=(const text_writer&) = delete;
+
+    /// writes what is left in the buffer
+    /// @note errors are ignored (e.g. an exception of the stream, during stack unwinding), cf. flush()
+    ~text_writer()
+    {
+        try
+        {
+            flush();
+        }
+        catch (...)
+        {
+        }
+    }
+
+    template <typename T>
+    void number(const T value)
+    {
+        reserve();
+        _used = static_cast<std::size_t>(formatNumber(_buffer + _used, value) - _buffer);
+    }
+
+    void put(const char c)
+    {
+        reserve();
+        _buffer[_used++] = c;
+    }
+
+    /// writes the buffered characters to the stream
+    /// @throw whatever the stream throws, depending on its exceptions() mask
+    void flush()
+    {
+        const std::size_t used = _used;
+        _used = 0;
+        _out.write(_buffer, static_cast<std::streamsize>(used));
+    }
+
+private:
+
+    /// makes room for a number (or a character)
+    void reserve()
+    {
+        if (_used + 32 > sizeof(_buffer))
+        {
+            flush();
+        }
+    }
+
+    std::ostream& _out;
+    std::size_t   _used;
+    char          _buffer[1 << 14];
+};
+
+[[noreturn]] HYPER_ARRAY_NOINLINE
+inline void textFormatError(const std::string& what)
+{
+    throw std::runtime_error("hyper_array::read_text(): " + what);
+}
 
-    /// Returns the length of a given dimension at run-time
-    size_type length(const size_type dimensionIndex) const
-    {
-        assert(dimensionIndex < Dimensions);
+/// 10^0 ... 10^22, i.e. the powers of 10 that are exact doubles
+inline double exactPowerOf10(const int e) noexcept
+{
+    static const double powers[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    return powers[e];
+}
 
-        return _lengths[dimensionIndex];
-    }
+inline float  parseWithStrtod(const char* text, char** end, float)  { return std::strtof(text, end); }
+inline double parseWithStrtod(const char* text, char** end, double) { return std::strtod(text, end); }
 
-    /// Returns a reference to the _lengths array
-    const ::std::array<size_type, Dimensions>& lengths() const noexcept
+/// slow path of parseNumber(): std::strtod(), i.e. correctly rounded
+/// `[first, last)` is expected to be a valid decimal number, whose '.' is replaced by `decimalPoint`, i.e. that of the C locale
+/// @note the numbers are copied (std::strtod() needs a null-terminated string) on the stack, or on the heap if they are long
+template <typename T>
+bool parseSlowly(const char* first, const char* last, const char decimalPoint, T& value)
+{
+    char stackBuffer[128];
+    std::string heapBuffer;
+    const std::size_t length = static_cast<std::size_t>(last - first);
+    char* buffer = stackBuffer;
+    if (length >= sizeof(stackBuffer))
     {
-        return _lengths;
+        heapBuffer.resize(length + 1);
+        buffer = &heapBuffer[0];
     }
-
-    /// Returns the given dimension's coefficient (used for computing the "linear" index)
-    size_type coeff(const size_type coeffIndex) const
+    std::memcpy(buffer, first, length);
+    buffer[length] = '\0';
+    for (char* c = buffer; c != buffer + length; ++c)
     {
-        assert(coeffIndex < Dimensions);
-
-        return _coeffs[coeffIndex];
+        *c = (*c == '.') ? decimalPoint : *c;
     }
+    char* end = nullptr;
+    value     = parseWithStrtod(buffer, &end, T{});
+    return end == buffer + length;
+}
 
-    /// Returns a reference to the _coeffs array
-    const ::std::array<size_type, Dimensions>& coeffs() const noexcept
+inline bool isDigit(const char c) noexcept
+{
+    return (c >= '0') && (c <= '9');
+}
+
+/// parses the number in [first, last), returns whether it is valid
+/// @param decimalPoint  the decimal point of the C locale, cf. parseSlowly()
+template <typename T>
+enable_if_t<std::is_floating_point<T>::value, bool>
+parseNumber(const char* first, const char* last, const char decimalPoint, T& value)
+{
+    static_assert(sizeof(T) <= 8, "long double is not supported");
+
+    // [-]digits[.digits][(e|E)[+|-]digits]
+    const char*   p        = first;
+    const bool    negative = (p != last) && (*p == '-');
+    std::uint64_t mantissa = 0;
+    int           digits   = 0;  // significant digits in mantissa
+    int           exponent = 0;
+    bool          any      = false;
+    p += (p != last) && ((*p == '-') || (*p == '+'));
+    for (; (p != last) && (*p == '0'); ++p)
     {
-        return _coeffs;
+        any = true;
     }
-
-    /// Returns the total number of elements in data
-    size_type size() const noexcept
+    for (; (p != last) && isDigit(*p); ++p, any = true)
     {
-        return _size;
+        mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+        ++digits;
     }
-
-    /// Returns a pointer to the allocated data array
-    value_type* data() noexcept
+    if ((p != last) && (*p == '.'))
     {
-        return _dataOwner.get();
+        ++p;
+        if (digits == 0)
+        {
+            for (; (p != last) && (*p == '0'); ++p, any = true)
+            {
+                --exponent;
+            }
+        }
+        for (; (p != last) && isDigit(*p); ++p, any = true)
+        {
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+            ++digits;
+            --exponent;
+        }
     }
-
-    /// `const` version of data()
-    const value_type* data() const noexcept
+    if (any && (p != last) && ((*p == 'e') || (*p == 'E')))
     {
-        return _dataOwner.get();
+        ++p;
+        const bool negativeExponent = (p != last) && (*p == '-');
+        p += (p != last) && ((*p == '-') || (*p == '+'));
+        int  e     = 0;
+        bool valid = false;
+        for (; (p != last) && isDigit(*p); ++p, valid = true)
+        {
+            e = (e < 10000) ? e * 10 + (*p - '0') : e;
+        }
+        any      = valid;
+        exponent = negativeExponent ? exponent - e : exponent + e;
     }
 
-    /// Returns the element at index `idx` in the data array
-    value_type& operator[](const index_type idx)
+    // Clinger's fast path: the mantissa and the power of 10 are exact, so is the correctly rounded product/quotient
+    constexpr int maxExponent = (sizeof(T) == 4) ? 10 : 22;
+    if (any && (p == last) && (digits <= 19)
+        && (mantissa <= (std::uint64_t{1} << std::numeric_limits<T>::digits))
+        && (-maxExponent <= exponent) && (exponent <= maxExponent))
     {
-        return _dataOwner[idx];
+        const T m = static_cast<T>(mantissa);
+        const T x = (exponent < 0) ? m / static_cast<T>(exactPowerOf10(-exponent))
+                                   : m * static_cast<T>(exactPowerOf10(exponent));
+        value = negative ? -x : x;
+        return true;
     }
 
-    /// `const` version of operator[]
-    const value_type& operator[](const index_type idx) const
+    // everything else: many digits, large exponents, nan, inf...
+    if ((last - first == 3) || (last - first == 4))
     {
-        return _dataOwner[idx];
+        const std::string word(first + (*first == '-'), last);
+        if ((word == "nan") || (word == "inf"))
+        {
+            value = (word == "nan") ? std::numeric_limits<T>::quiet_NaN()
+                  : ((*first == '-') ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::infinity());
+            return true;
+        }
     }
+    return any && (p == last) && parseSlowly(first, last, decimalPoint, value);
+}
 
-    /// Returns the element at the given index tuple
-    /// Usage:
-    /// @code
-    ///     hyper_array::array<double, 3> arr(4, 5, 6);
-    ///     arr.at(3, 1, 4) = 3.14;
-    /// @endcode
-    template <typename... Indices>
-    internal::enable_if_t<
-        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
-        value_type&>
-    at(Indices... indices)
+template <typename T>
+enable_if_t<std::is_integral<T>::value, bool>
+parseNumber(const char* first, const char* last, char, T& value) noexcept
+{
+    const bool negative = (first != last) && (*first == '-');
+    first += (first != last) && ((*first == '-') || (*first == '+'));
+    if ((first == last) || (negative && std::is_unsigned<T>::value))
     {
-        return _dataOwner[rawIndex_checkBounds(indices...)];
+        return false;
     }
 
-    /// `const` version of at()
-    template <typename... Indices>
-    internal::enable_if_t<
-        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
-        const value_type&>
-    at(Indices... indices) const
+    // accumulated as a negative number when `negative`, i.e. the minimum value can be parsed
+    using wide_type = typename std::conditional<std::is_signed<T>::value, std::int64_t, std::uint64_t>::type;
+    const wide_type limit = negative ? static_cast<wide_type>(std::numeric_limits<T>::min())
+                                     : static_cast<wide_type>(std::numeric_limits<T>::max());
+    const wide_type limitDigit = negative ? -(limit % 10) : limit % 10;
+    wide_type result = 0;
+    for (; first != last; ++first)
     {
-        return _dataOwner[rawIndex_checkBounds(indices...)];
+        if (!isDigit(*first))
+        {
+            return false;
+        }
+        const wide_type digit = static_cast<wide_type>(*first - '0');
+        if (negative ? ((result < limit / 10) || ((result == limit / 10) && (digit > limitDigit)))
+                     : ((result > limit / 10) || ((result == limit / 10) && (digit > limitDigit))))
+        {
+            return false;  // overflow
+        }
+        result = negative ? result * 10 - digit : result * 10 + digit;
     }
+    value = static_cast<T>(result);
+    return true;
+}
 
-    /// Unchecked version of at()
-    /// Usage:
-    /// @code
-    ///     hyper_array::array<double, 3> arr(4, 5, 6);
-    ///     arr(3, 1, 4) = 3.14;
-    /// @endcode
-    template <typename... Indices>
-    internal::enable_if_t<
-        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
-        value_type&>
-    operator()(Indices... indices)
+}
+
+/// options of write_text()
+struct text_options
+{
+    /// written between the elements of a row
+    char separator = ' ';
+
+    /// whether the rows are written on separate lines
+    /// When enabled, each row (i.e. the elements along the fastest dimension according to the array's order)
+    /// ends with a line break, and each block of the slower dimensions (planes, ...) ends with an additional one.
+    /// e.g. a {2, 2, 3} ROW_MAJOR array is written as "0 1 2\n3 4 5\n\n6 7 8\n9 10 11\n\n\n"
+    /// Otherwise, all the elements are written on a single line.
+    bool lineBreaks = true;
+};
+
+/// Writes the elements of a view as text, in a format that read_text() can read back
+///
+/// Integers are written as-is, floating point numbers use the shortest representation that reads back as the
+/// same value (e.g. "0.1", "1e+100", "-inf"). The conversions don't depend on the stream's locale or flags,
+/// and the characters are written to the stream in large blocks.
+///
+/// Usage:
+/// @code
+///     std::ofstream file{"grid.txt"};
+///     hyper_array::write_text(file, grid);
+/// @endcode
+/// @see text_options
+template <typename ValueType, std::size_t Dimensions, array_order Order>
+void write_text(std::ostream& out, const array_view<ValueType, Dimensions, Order>& view, const text_options& options = text_options())
+{
+    using value_type = typename std::remove_const<ValueType>::type;
+    static_assert(internal::is_text_number<value_type>::value, "write_text() supports integers, float and double");
+
+    if (view.size() == 0)
     {
-        return _dataOwner[rawIndex_noChecks({{static_cast<index_type>(indices)...}})];
+        return;
     }
 
-    /// `const` version of operator()
-    template <typename... Indices>
-    internal::enable_if_t<
-        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
-        const value_type&>
-    operator()(Indices... indices) const
+    internal::text_writer writer(out);
+    const std::size_t    dim       = internal::dimensionByRank<Order, Dimensions>(0);
+    const std::size_t    rowLength = view.length(dim);
+    const std::size_t    rows      = view.size() / rowLength;
+    const std::ptrdiff_t stride    = view.coeff(dim);
+
+    // blockRows[r]: number of rows in a block of the dimensions of rank [1, r]
+    ::std::array<std::size_t, Dimensions> blockRows;
+    blockRows[0] = 1;
+    for (std::size_t rank = 1; rank < Dimensions; ++rank)
     {
-        return _dataOwner[rawIndex_noChecks({{static_cast<index_type>(indices)...}})];
+        blockRows[rank] = blockRows[rank - 1] * view.length(internal::dimensionByRank<Order, Dimensions>(rank));
     }
 
-    /// returns the actual index of the element in the data array
-    /// Usage:
-    /// @code
-    ///     hyper_array::array<int, 3> arr(4, 5, 6);
-    ///     assert(&arr.at(3, 1, 4) == &arr.data()[arr.rawIndex(3, 1, 4)]);
-    /// @endcode
-    template <typename... Indices>
-    internal::enable_if_t<
-        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
-        index_type>
-    rawIndex(Indices... indices) const
+    ::std::array<std::size_t, Dimensions> indices{};
+    for (std::size_t row = 1; row <= rows; ++row)
     {
-        return rawIndex_checkBounds(indices...);
+        const ValueType* element = view.data() + internal::stridedOffset(view.coeffs(), indices);
+        for (std::size_t k = 1; k < rowLength; ++k, element += stride)
+        {
+            writer.number(*element);
+            writer.put(options.separator);
+        }
+        writer.number(*element);
+        internal::nextRow<Order>(indices, view.lengths(), dim);
+
+        if (!options.lineBreaks)
+        {
+            writer.put((row == rows) ? '\n' : options.separator);
+            continue;
+        }
+        // one line break per block that ends with this row
+        writer.put('\n');
+        for (std::size_t rank = 1; (rank < Dimensions) && (row % blockRows[rank] == 0); ++rank)
+        {
+            writer.put('\n');
+        }
     }
+    writer.flush();
+}
 
-private:
+/// Writes the elements of a hyper array as text, @see write_text(std::ostream&, const array_view&, const text_options&)
+template <typename ValueType, std::size_t Dimensions, array_order Order, typename Allocator>
+void write_text(std::ostream& out, const array<ValueType, Dimensions, Order, Allocator>& arr, const text_options& options = text_options())
+{
+    write_text(out, arr.view(), options);
+}
 
-    template <typename... Indices>
-    internal::enable_if_t<
-        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
-        ::std::array<index_type, Dimensions>>
-    validateIndexRanges(Indices... indices) const
-    {
-        ::std::array<index_type, Dimensions> indexArray = {{static_cast<index_type>(indices)...}};
+/// Reads a hyper array that was written by write_text()
+///
+/// The lengths are deduced from the line breaks: the first row gives the length of the fastest dimension
+/// (according to `Order`), the first block of rows (i.e. rows followed by an empty line) gives the length of the next one, etc.
+/// The elements can be separated by spaces, tabs or commas. The numbers are parsed independently of the stream's locale.
+///
+/// @note the numbers that the fast path can't parse exactly are parsed by std::strtod(), using the decimal point of
+///       the C locale, which is looked up once per call with std::localeconv(): that isn't thread-safe with regard to
+///       std::setlocale(), i.e. the C locale must not be changed while another thread runs read_text()
+///
+/// Usage:
+/// @code
+///     std::ifstream file{"grid.txt"};
+///     auto grid = hyper_array::read_text<double, 3>(file);
+/// @endcode
+/// @throw std::runtime_error if a number is invalid, or if the rows/blocks don't all have the same length
+template <
+    typename    ValueType,
+    std::size_t Dimensions,
+    array_order Order     = array_order::ROW_MAJOR,
+    typename    Allocator = std::allocator<ValueType>
+>
+array<ValueType, Dimensions, Order, Allocator> read_text(std::istream& in)
+{
+    static_assert(internal::is_text_number<ValueType>::value, "read_text() supports integers, float and double");
 
-        // check all indices and prepare an exhaustive report (in oss)
-        // if some of them are out of bounds
-        std::ostringstream oss;
-        for (index_type i = 0; i < Dimensions; ++i)
+    // the whole text, read in large blocks
+    std::string text;
+    {
+        char buffer[1 << 14];
+        while (in.read(buffer, sizeof(buffer)), in.gcount() > 0)
         {
-            if ((indexArray[i] >= _lengths[i]) || (indexArray[i] < 0))
-            {
-                oss << "Index #" << i << " [== " << indexArray[i] << "]"
-                    << " is out of the [0, " << (_lengths[i]-1) << "] range. ";
-            }
+            text.append(buffer, static_cast<std::size_t>(in.gcount()));
         }
-
-        // if nothing has been written to oss then all indices are valid
-        assert(oss.str().empty());
-        return indexArray;
-        //if (oss.str().empty())
-        //{
-        //    return indexArray;
-        //}
-        //else
-        //{
-        //    throw std::out_of_range(oss.str());
-        //}
     }
 
-    template <typename... Indices>
-    internal::enable_if_t<
-        (sizeof...(Indices) == Dimensions) && internal::are_integral<Indices...>::value,
-        index_type>
-    rawIndex_checkBounds(Indices... indices) const
+    // for std::strtod(), in the slow path of the floating point numbers
+    const char decimalPoint = std::is_floating_point<ValueType>::value ? *std::localeconv()->decimal_point : '.';
+
+    // the elements, and the number of dimensions that end before each of them (i.e. line breaks)
+    std::vector<ValueType>     values;
+    std::vector<std::uint8_t>  breaks;
+    const char*                p         = text.data();
+    const char* const          end       = p + text.size();
+    std::size_t                lineBreaks = 0;
+    while (p != end)
     {
-        return rawIndex_noChecks(validateIndexRanges(indices...));
+        if (*p == '\n')
+        {
+            ++lineBreaks;
+            ++p;
+        }
+        else if ((*p == ' ') || (*p == '\t') || (*p == ',') || (*p == '\r'))
+        {
+            ++p;
+        }
+        else
+        {
+            const char* last = p;
+            while ((last != end) && (*last != ' ') && (*last != '\t') && (*last != ',') && (*last != '\r') && (*last != '\n'))
+            {
+                ++last;
+            }
+            ValueType value{};
+            if (!internal::parseNumber(p, last, decimalPoint, value))
+            {
+                internal::textFormatError("invalid number \"" + std::string(p, last) + "\"");
+            }
+            if (!values.empty() && (lineBreaks >= Dimensions))
+            {
+                internal::textFormatError("too many consecutive line breaks before element #" + std::to_string(values.size()));
+            }
+            breaks.push_back(values.empty() ? 0 : static_cast<std::uint8_t>(lineBreaks));
+            values.push_back(value);
+            lineBreaks = 0;
+            p          = last;
+        }
     }
 
-    constexpr
-    index_type
-    rawIndex_noChecks(const ::std::array<index_type, Dimensions>& indexArray) const noexcept
+    // blockSizes[d]: number of elements in a block that ends with d line breaks
+    ::std::array<std::size_t, Dimensions + 1> blockSizes;
+    blockSizes.fill(values.size());
+    blockSizes[0] = 1;
+    for (std::size_t i = values.size(); i-- > 1; )
     {
-        /* https://www.codecogs.com/latex/eqneditor.php
-           \begin{cases}
-           I_{actual} &= \sum_{i=0}^{N-1} {C_i \cdot I_i}                  \\
-                                                                           \\
-           I_{actual} &: \text{actual index of the data in the data array} \\
-           N          &: \text{Dimensions}                                 \\
-           C_i        &: \text{\_coeffs[i]}                                \\
-           I_i        &: \text{indexArray[i]}
-           \end{cases}
-        */
-        return internal::ct_inner_product(_coeffs, 0,
-                                          indexArray, 0,
-                                          Dimensions,
-                                          static_cast<index_type>(0),
-                                          internal::ct_plus<index_type>,
-                                          internal::ct_prod<index_type>);
+        for (std::size_t d = 1; d <= breaks[i]; ++d)
+        {
+            blockSizes[d] = i;
+        }
     }
-
-    /// computes the total number of elements in a data array
-    static
-    constexpr
-    size_type
-    computeDataSize(const ::std::array<size_type, Dimensions>& dimensionLengths) noexcept
+    ::std::array<std::size_t, Dimensions> lengths{};
+    for (std::size_t d = 0; (d < Dimensions) && !values.empty(); ++d)
     {
-        return internal::ct_accumulate(dimensionLengths,
-                                       0,
-                                       Dimensions,
-                                       static_cast<size_type>(1),
-                                       internal::ct_prod<size_type>);
+        if ((blockSizes[d + 1] < blockSizes[d]) || (blockSizes[d + 1] % blockSizes[d] != 0))
+        {
+            internal::textFormatError("the rows don't all have the same length");
+        }
+        lengths[internal::dimensionByRank<Order, Dimensions>(d)] = blockSizes[d + 1] / blockSizes[d];
     }
-
-    static
-    std::unique_ptr<value_type[]> allocateData(const size_type elementCount)
+    for (std::size_t i = 1; i < values.size(); ++i)
     {
-        #if (__cplusplus < 201402L)  // C++14 ?
-        return std::unique_ptr<value_type[]>{new value_type[elementCount]};
-        #else
-        // std::make_unique() is not part of C++11
-        return std::make_unique<value_type[]>(elementCount);
-        #endif
-
+        std::size_t expected = 0;
+        while ((expected + 1 < Dimensions) && (i % blockSizes[expected + 1] == 0))
+        {
+            ++expected;
+        }
+        if (breaks[i] != expected)
+        {
+            internal::textFormatError("the rows don't all have the same length (element #" + std::to_string(i) + ")");
+        }
     }
 
-    std::unique_ptr<value_type[]> cloneData() const
+    array<ValueType, Dimensions, Order, Allocator> result{uninitialized, lengths};
+    auto element = result.begin();
+    for (const ValueType& value : values)
     {
-        // allocate the new data container
-        std::unique_ptr<value_type[]> dataOwner{allocateData(size())};
-
-        // copy data to the the new container
-        std::copy(_dataOwner.get(),
-                  _dataOwner.get() + size(),
-                  dataOwner.get());
-
-        return dataOwner;
+        *element++ = value;
     }
-
-};
+    return result;
+}
+// </editor-fold>
 
 // <editor-fold desc="orca_array-like declarations">
 template<typename ValueType> using array1d = array<ValueType, 1>;
@@ -672,6 +8401,36 @@ inline void copyToStream(ContainerType&& container, std::ostream& out, const cha
               std::ostream_iterator<decltype(*container.begin())>(out, separator));
 }
 
+/// whether the elements of type `T` are printed with hyper_array's formatter, rather than the stream's
+/// (characters are still printed as characters)
+template <typename T>
+using is_fast_printable = std::integral_constant<
+    bool,
+    is_text_number<T>::value && ((sizeof(T) > 1) || std::is_same<T, bool>::value)>;
+
+/// same as copyToStream(), for the elements of a hyper array
+template <typename ContainerType>
+inline enable_if_t<!is_fast_printable<typename std::decay<ContainerType>::type::value_type>::value, void>
+copyDataToStream(ContainerType&& container, std::ostream& out)
+{
+    copyToStream(container, out);
+}
+
+/// writes the numbers with write_text()'s buffered formatter: the output doesn't depend on the stream's locale nor
+/// precision, and floating point numbers are printed with all the digits that are needed for reading them back
+template <typename ContainerType>
+inline enable_if_t<is_fast_printable<typename std::decay<ContainerType>::type::value_type>::value, void>
+copyDataToStream(ContainerType&& container, std::ostream& out)
+{
+    text_writer writer(out);
+    for (const auto& x : container)
+    {
+        writer.number(x);
+        writer.put(' ');
+    }
+    writer.flush();
+}
+
 }
 }
 
@@ -681,18 +8440,57 @@ inline void copyToStream(ContainerType&& container, std::ostream& out, const cha
 /// @code
 ///     [dimensions: 2 ][order: ROW_MAJOR ][lengths: 3 4 ][coeffs: 4 1 ][size: 12 ][data: 1 2 3 4 5 6 7 8 9 10 11 12 ]
 /// @endcode
-template <typename ValueType, size_t Dimensions, hyper_array::array_order Order>
+template <typename ValueType, size_t Dimensions, hyper_array::array_order Order, typename Allocator>
+inline std::ostream& operator<<(std::ostream& out,
+                                const hyper_array::array<ValueType, Dimensions, Order, Allocator>& ha)
+{
+    using hyper_array::internal::copyToStream;
+    using hyper_array::internal::copyDataToStream;
+
+    out << "[dimensions: " << ha.dimensions()                 << " ]";
+    out << "[order: "      << ha.order()                      << " ]";
+    out << "[lengths: "     ; copyToStream(ha.lengths(), out) ; out << "]";
+    out << "[coeffs: "      ; copyToStream(ha.coeffs(), out)  ; out << "]";
+    out << "[size: "       << ha.size()                       << " ]";
+    out << "[data: "        ; copyDataToStream(ha, out)       ; out << "]";
+
+    return out;
+}
+
+/// Pretty printing of static arrays to the standard library's streams
+/// @see operator<<(std::ostream&, const hyper_array::array&)
+template <typename ValueType, typename Extents, hyper_array::array_order Order>
 inline std::ostream& operator<<(std::ostream& out,
-                                const hyper_array::array<ValueType, Dimensions, Order>& ha)
+                                const hyper_array::static_array<ValueType, Extents, Order>& ha)
 {
     using hyper_array::internal::copyToStream;
+    using hyper_array::internal::copyDataToStream;
 
     out << "[dimensions: " << ha.dimensions()                 << " ]";
     out << "[order: "      << ha.order()                      << " ]";
     out << "[lengths: "     ; copyToStream(ha.lengths(), out) ; out << "]";
     out << "[coeffs: "      ; copyToStream(ha.coeffs(), out)  ; out << "]";
     out << "[size: "       << ha.size()                       << " ]";
-    out << "[data: "        ; copyToStream(ha, out)           ; out << "]";
+    out << "[data: "        ; copyDataToStream(ha, out)       ; out << "]";
+
+    return out;
+}
+
+/// Pretty printing of hyper array views to the standard library's streams
+/// @see operator<<(std::ostream&, const hyper_array::array&)
+template <typename ValueType, size_t Dimensions, hyper_array::array_order Order>
+inline std::ostream& operator<<(std::ostream& out,
+                                const hyper_array::array_view<ValueType, Dimensions, Order>& hv)
+{
+    using hyper_array::internal::copyToStream;
+    using hyper_array::internal::copyDataToStream;
+
+    out << "[dimensions: " << hv.dimensions()                 << " ]";
+    out << "[order: "      << hv.order()                      << " ]";
+    out << "[lengths: "     ; copyToStream(hv.lengths(), out) ; out << "]";
+    out << "[coeffs: "      ; copyToStream(hv.coeffs(), out)  ; out << "]";
+    out << "[size: "       << hv.size()                       << " ]";
+    out << "[data: "        ; copyDataToStream(hv, out)       ; out << "]";
 
     return out;
 }
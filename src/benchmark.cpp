@@ -0,0 +1,550 @@
+
+// g++ -std=c++11 -O3 -DNDEBUG ${file} -o ${file_path}/${file_base_name}
+// build in release mode (e.g. cmake -DCMAKE_BUILD_TYPE=Release) in order to get meaningful figures
+
+// std
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+// hyper_array
+#include "../include/hyper_array/hyper_array.hpp"
+
+using std::cout;
+using std::endl;
+
+using hyper_array::array_order;
+
+namespace
+{
+
+/// number of times each benchmark is run, the best time is kept
+constexpr int repetitions = 5;
+
+/// runs `f` a few times then prints the bandwidth, given the number of bytes that `f` reads and writes
+void measure(const std::string& name, const double bytes, const std::function<void()>& f)
+{
+    double best = 1e300;
+    for (int r = 0; r < repetitions; ++r)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+        const auto stop  = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+
+    cout << "    " << std::left << std::setw(40) << name
+         << std::right << std::fixed << std::setprecision(2) << std::setw(8) << (bytes / best / 1e9) << " GB/s"
+         << std::setw(10) << (best * 1e3) << " ms" << endl;
+}
+
+/// keeps the compiler from optimizing the benchmarked code away
+template <typename HyperArray>
+void use(const HyperArray& ha)
+{
+    volatile double sink = ha[ha.size() / 3];
+    (void)sink;
+}
+
+/// ROW_MAJOR -> COLUMN_MAJOR conversion of a `Dimensions`-dimension array
+template <std::size_t Dimensions>
+void orderConversion(const std::array<std::size_t, Dimensions>& lengths)
+{
+    using row_type = hyper_array::array<double, Dimensions, array_order::ROW_MAJOR>;
+    using col_type = hyper_array::array<double, Dimensions, array_order::COLUMN_MAJOR>;
+
+    row_type row{lengths};
+    std::iota(row.begin(), row.end(), 0.0);
+    const double bytes = 2.0 * static_cast<double>(row.size() * sizeof(double));
+
+    cout << "  " << Dimensions << "D [lengths: ";
+    hyper_array::internal::copyToStream(lengths, cout);
+    cout << "] " << (bytes / 2 / (1 << 20)) << " MiB" << endl;
+
+    col_type col{hyper_array::uninitialized, lengths};
+    measure("memcpy (reference)", bytes, [&] {
+        std::memcpy(col.data(), row.data(), row.size() * sizeof(double));
+        use(col);
+    });
+
+    measure("naive (element by element)", bytes, [&] {
+        auto dst = col.data();
+        for (auto src = row.view().transpose().begin(), end = row.view().transpose().end(); src != end; ++src)
+        {
+            *dst++ = *src;
+        }
+        use(col);
+    });
+
+    measure("hyper_array::copy()", bytes, [&] {
+        hyper_array::copy(row.view(), col.view());
+        use(col);
+    });
+
+    measure("converting constructor", bytes, [&] {
+        const col_type converted{row};
+        use(converted);
+    });
+}
+
+
+/// element-wise kernels over cache-resident data, for each instruction set supported by the machine
+template <typename T>
+void elementwiseKernels(const std::size_t size)
+{
+    using hyper_array::simd::instruction_set;
+
+    hyper_array::array<T, 1> a{size};
+    hyper_array::array<T, 1> b{size};
+    hyper_array::array<T, 1> out{size};
+    hyper_array::array<bool, 1> mask{size};
+    std::iota(a.begin(), a.end(), T(1));
+    std::iota(b.rbegin(), b.rend(), T(1));
+
+    constexpr int iterations = 10000;
+    const double bytes = 3.0 * iterations * static_cast<double>(size * sizeof(T));
+
+    cout << "  " << ((sizeof(T) == 4) ? "float" : "double") << " [size: " << size << "]" << endl;
+
+    measure("plain loop: a + b", bytes, [&] {
+        for (int it = 0; it < iterations; ++it)
+        {
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                out[i] = a[i] + b[i];
+            }
+            use(out);
+        }
+    });
+
+    const instruction_set detected = hyper_array::simd::detected_instruction_set();
+    for (int isa = 0; isa <= static_cast<int>(detected); ++isa)
+    {
+        hyper_array::simd::set_instruction_set(static_cast<instruction_set>(isa));
+        const std::string name = hyper_array::simd::instruction_set_name(static_cast<instruction_set>(isa));
+
+        measure(name + ": add(a, b)", bytes, [&] {
+            for (int it = 0; it < iterations; ++it)
+            {
+                hyper_array::simd::add(a, b, out);
+                use(out);
+            }
+        });
+        measure(name + ": fma(a, b, a)", bytes * 4 / 3, [&] {
+            for (int it = 0; it < iterations; ++it)
+            {
+                hyper_array::simd::fma(a, b, a, out);
+                use(out);
+            }
+        });
+        measure(name + ": max(a, b)", bytes, [&] {
+            for (int it = 0; it < iterations; ++it)
+            {
+                hyper_array::simd::max(a, b, out);
+                use(out);
+            }
+        });
+        measure(name + ": compare(less, a, b)", bytes, [&] {
+            for (int it = 0; it < iterations; ++it)
+            {
+                hyper_array::simd::compare(hyper_array::simd::comparison::less, a, b, mask);
+                use(mask);
+            }
+        });
+    }
+    hyper_array::simd::set_instruction_set(detected);
+}
+
+
+/// sums a 2D ROW_MAJOR array along each axis
+void axisReductions(const std::size_t rows, const std::size_t columns)
+{
+    hyper_array::array<double, 2> arr{rows, columns};
+    std::iota(arr.begin(), arr.end(), 0.0);
+    const double bytes = static_cast<double>(arr.size() * sizeof(double));
+
+    cout << "  [lengths: " << rows << " " << columns << "] " << (bytes / (1 << 20)) << " MiB" << endl;
+
+    hyper_array::array<double, 1> perColumn{columns};
+    hyper_array::array<double, 1> perRow{rows};
+
+    measure("naive sum along axis 0 (strided)", bytes, [&] {
+        for (std::size_t j = 0; j < columns; ++j)
+        {
+            double acc = 0.0;
+            for (std::size_t i = 0; i < rows; ++i)
+            {
+                acc += arr(i, j);
+            }
+            perColumn[j] = acc;
+        }
+        use(perColumn);
+    });
+
+    measure("naive sum along axis 1 (contiguous)", bytes, [&] {
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            double acc = 0.0;
+            for (std::size_t j = 0; j < columns; ++j)
+            {
+                acc += arr(i, j);
+            }
+            perRow[i] = acc;
+        }
+        use(perRow);
+    });
+
+    measure("hyper_array::sum(arr, 0)", bytes, [&] {
+        perColumn = hyper_array::sum(arr, 0);
+        use(perColumn);
+    });
+
+    measure("hyper_array::sum(arr, 1)", bytes, [&] {
+        perRow = hyper_array::sum(arr, 1);
+        use(perRow);
+    });
+}
+
+/// subtracts a row vector from each row of a 2D ROW_MAJOR array: expanded copy vs broadcasting
+void broadcastRow(const std::size_t rows, const std::size_t columns)
+{
+    hyper_array::array<double, 2> arr{rows, columns};
+    hyper_array::array<double, 1> row{columns};
+    hyper_array::array<double, 2> out{rows, columns};
+    std::iota(arr.begin(), arr.end(), 0.0);
+    std::iota(row.begin(), row.end(), 0.0);
+    const double bytes = static_cast<double>(arr.size() * sizeof(double));
+
+    cout << "  [lengths: " << rows << " " << columns << "] " << (bytes / (1 << 20)) << " MiB" << endl;
+
+    measure("naive loop", bytes, [&] {
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            for (std::size_t j = 0; j < columns; ++j)
+            {
+                out(i, j) = arr(i, j) - row(j);
+            }
+        }
+        use(out);
+    });
+
+    measure("expanded copy, then arr - copy", bytes, [&] {
+        hyper_array::array<double, 2> expanded{rows, columns};
+        for (std::size_t i = 0; i < rows; ++i)
+        {
+            std::copy(row.begin(), row.end(), expanded.begin() + static_cast<std::ptrdiff_t>(i * columns));
+        }
+        out = arr - expanded;
+        use(out);
+    });
+
+    measure("arr - row (broadcast)", bytes, [&] {
+        out = arr - row;
+        use(out);
+    });
+}
+
+/// writes and reads back an array: text (standard streams vs write_text/read_text) vs binary (save/load) vs mapping
+void fileIO(const std::size_t length)
+{
+    hyper_array::array<double, 2> arr{length, length};
+    std::iota(arr.begin(), arr.end(), 0.25);
+    arr /= 7.0;
+    const double      bytes = static_cast<double>(arr.size() * sizeof(double));
+    const std::string path  = "hyper_array_benchmark.ha";
+
+    cout << "  [lengths: " << length << " " << length << "] " << (bytes / (1 << 20)) << " MiB" << endl;
+
+    // the former operator<<(): one formatted insertion per element, with enough digits for reading the values back
+    measure("std::ostream_iterator (text, to memory)", bytes, [&] {
+        std::ostringstream text;
+        text.precision(17);
+        std::copy(arr.begin(), arr.end(), std::ostream_iterator<double>(text, " "));
+        volatile std::size_t sink = text.str().size();
+        (void)sink;
+    });
+
+    measure("operator<< (text, to memory)", bytes, [&] {
+        std::ostringstream text;
+        text << arr;
+        volatile std::size_t sink = text.str().size();
+        (void)sink;
+    });
+
+    std::string text;
+    measure("hyper_array::write_text() (to memory)", bytes, [&] {
+        std::ostringstream out;
+        hyper_array::write_text(out, arr);
+        text = out.str();
+    });
+
+    measure("std::istream >> (text, from memory)", bytes, [&] {
+        std::istringstream in{text};
+        hyper_array::array<double, 2> loaded{hyper_array::uninitialized, length, length};
+        for (auto& x : loaded)
+        {
+            in >> x;
+        }
+        use(loaded);
+    });
+
+    measure("hyper_array::read_text() (from memory)", bytes, [&] {
+        std::istringstream in{text};
+        const auto loaded = hyper_array::read_text<double, 2>(in);
+        use(loaded);
+    });
+
+    measure("hyper_array::save()", bytes, [&] {
+        hyper_array::save(path, arr);
+    });
+
+    measure("hyper_array::load()", bytes, [&] {
+        const auto loaded = hyper_array::load<double, 2>(path);
+        use(loaded);
+    });
+
+    #if HYPER_ARRAY_MEMORY_MAPPING
+    measure("mapped_array::open() + sum", bytes, [&] {
+        const auto mapped = hyper_array::mapped_array<const double, 2>::open(path);
+        volatile double sink = std::accumulate(mapped.data(), mapped.data() + mapped.size(), 0.0);
+        (void)sink;
+    });
+    #endif
+
+    std::remove(path.c_str());
+}
+
+/// processes a {T, H, W} file frame by frame: synchronous reads vs read-ahead with hyperslab_reader
+void hyperslabStreaming(const std::size_t frames, const std::size_t height, const std::size_t width)
+{
+    const std::string path  = "hyper_array_benchmark_frames.ha";
+    const double      bytes = static_cast<double>(frames * height * width * sizeof(float));
+    {
+        auto file = hyper_array::array_file<float, 3>::create(path, frames, height, width);
+        hyper_array::array<float, 3> frame{1, height, width};
+        for (std::size_t t = 0; t < frames; ++t)
+        {
+            std::iota(frame.begin(), frame.end(), static_cast<float>(t));
+            file.write({{t, 0, 0}, frame.lengths()}, frame);
+        }
+    }
+    const auto input = hyper_array::array_file<const float, 3>::open(path);
+    const auto slabs = hyper_array::tile_hyperslabs(input.lengths(), {{4, height, width}});
+
+    cout << "  [lengths: " << frames << " " << height << " " << width << "] " << (bytes / (1 << 20)) << " MiB, "
+         << "slabs of 4 frames" << endl;
+
+    // a few operations per element, i.e. roughly as long as reading the elements from the page cache
+    const auto process = [](const hyper_array::array_view<float, 3>& slab)
+    {
+        float sum = 0.0f;
+        for (const float x : slab)
+        {
+            sum += std::sqrt(x) * 0.5f + 1.0f;
+        }
+        volatile float sink = sum;
+        (void)sink;
+    };
+
+    measure("array_file::read() + process", bytes, [&] {
+        hyper_array::array<float, 3> buffer{4, height, width};
+        for (const auto& slab : slabs)
+        {
+            hyper_array::array_view<float, 3> view{buffer.data(), slab.lengths, buffer.view().coeffs()};
+            input.read(slab, view);
+            process(view);
+        }
+    });
+
+    measure("hyperslab_reader + process", bytes, [&] {
+        hyper_array::hyperslab_reader<float, 3> reader{input, slabs};
+        while (reader.next())
+        {
+            process(reader.view());
+        }
+    });
+
+    std::remove(path.c_str());
+}
+
+/// fills a 3D ROW_MAJOR array from its indices: loop nest vs nd_cursor vs parallel_for_each()
+void forEachIndexed(const std::size_t length)
+{
+    hyper_array::array<double, 3> arr{length, length, length};
+    const double bytes = static_cast<double>(arr.size() * sizeof(double));
+
+    cout << "  [lengths: " << length << " " << length << " " << length << "] " << (bytes / (1 << 20)) << " MiB, "
+         << hyper_array::default_thread_pool().size() << " thread(s)" << endl;
+
+    measure("loop nest over arr(i, j, k)", bytes, [&] {
+        for (std::size_t i = 0; i < length; ++i)
+        for (std::size_t j = 0; j < length; ++j)
+        for (std::size_t k = 0; k < length; ++k)
+        {
+            arr(i, j, k) = static_cast<double>(i + 2 * j + 3 * k);
+        }
+        use(arr);
+    });
+
+    measure("hyper_array::nd_cursor", bytes, [&] {
+        for (auto c = arr.cursor(); c.valid(); ++c)
+        {
+            *c = static_cast<double>(c.index(0) + 2 * c.index(1) + 3 * c.index(2));
+        }
+        use(arr);
+    });
+
+    measure("hyper_array::parallel_for_each(arr, f)", bytes, [&] {
+        hyper_array::parallel_for_each(arr, [](double& x, std::size_t i, std::size_t j, std::size_t k) {
+            x = static_cast<double>(i + 2 * j + 3 * k);
+        });
+        use(arr);
+    });
+}
+
+/// reads a 3D array through operator() (unchecked) and at() (checked, cf. HYPER_ARRAY_CONFIG_Bounds_Check)
+void checkedAccess(const std::size_t length)
+{
+    hyper_array::array<double, 3> arr{length, length, length};
+    std::iota(arr.begin(), arr.end(), 0.0);
+    const double bytes = static_cast<double>(arr.size() * sizeof(double));
+
+    cout << "  [lengths: " << length << " " << length << " " << length << "] " << (bytes / (1 << 20)) << " MiB" << endl;
+
+    double total = 0.0;
+    measure("arr(i, j, k)", bytes, [&] {
+        for (std::size_t i = 0; i < length; ++i)
+        for (std::size_t j = 0; j < length; ++j)
+        for (std::size_t k = 0; k < length; ++k)
+        {
+            total += arr(i, j, k);
+        }
+    });
+    measure("arr.at(i, j, k)", bytes, [&] {
+        for (std::size_t i = 0; i < length; ++i)
+        for (std::size_t j = 0; j < length; ++j)
+        for (std::size_t k = 0; k < length; ++k)
+        {
+            total += arr.at(i, j, k);
+        }
+    });
+    cout << "  (" << total << ")" << endl;
+}
+
+/// converts offsets into multi-indices: array::multiIndex() (divisions) vs index_unraveler (multiplications)
+void unravelIndex(const std::size_t length)
+{
+    hyper_array::array<float, 3> arr{length, length + 1, length + 3};
+    std::vector<std::size_t> offsets(arr.size());
+    std::iota(offsets.begin(), offsets.end(), std::size_t{0});
+    std::vector<std::array<std::size_t, 3>> indices(offsets.size());
+    const double bytes = static_cast<double>(offsets.size() * (sizeof(std::size_t) + sizeof(indices[0])));
+
+    cout << "  [lengths: " << arr.length(0) << " " << arr.length(1) << " " << arr.length(2) << "]" << endl;
+
+    measure("arr.multiIndex(offset)", bytes, [&] {
+        for (std::size_t i = 0; i < offsets.size(); ++i)
+        {
+            indices[i] = arr.multiIndex(offsets[i]);
+        }
+        volatile std::size_t sink = indices[indices.size() / 3][1];
+        (void)sink;
+    });
+
+    measure("hyper_array::index_unraveler", bytes, [&] {
+        const hyper_array::index_unraveler<3> unraveler{arr.lengths()};
+        unraveler(offsets.begin(), offsets.end(), indices.begin());
+        volatile std::size_t sink = indices[indices.size() / 3][1];
+        (void)sink;
+    });
+}
+
+/// reduces a large 2D ROW_MAJOR array serially, then with hyper_array::par
+void parallelReductions(const std::size_t rows, const std::size_t columns)
+{
+    hyper_array::array<double, 2> arr{rows, columns};
+    std::iota(arr.begin(), arr.end(), 0.5);
+    const double bytes = static_cast<double>(arr.size() * sizeof(double));
+
+    cout << "  [lengths: " << rows << " " << columns << "] " << (bytes / (1 << 20)) << " MiB, "
+         << hyper_array::default_thread_pool().size() << " thread(s)" << endl;
+
+    double total = 0.0;
+    measure("hyper_array::sum(arr)", bytes, [&] {
+        total += hyper_array::sum(arr);
+    });
+    measure("hyper_array::sum(par, arr)", bytes, [&] {
+        total += hyper_array::sum(hyper_array::par, arr);
+    });
+    measure("hyper_array::sum(par.deterministic(), arr)", bytes, [&] {
+        total += hyper_array::sum(hyper_array::par.deterministic(), arr);
+    });
+
+    hyper_array::array<double, 1> perColumn{columns};
+    measure("hyper_array::sum(arr, 0)", bytes, [&] {
+        perColumn = hyper_array::sum(arr, 0);
+        use(perColumn);
+    });
+    measure("hyper_array::sum(par, arr, 0)", bytes, [&] {
+        perColumn = hyper_array::sum(hyper_array::par, arr, 0);
+        use(perColumn);
+    });
+    cout << "  (" << total << ")" << endl;
+}
+
+}
+
+int main()
+{
+    #ifndef NDEBUG
+    cout << "warning: this benchmark should be built in release mode" << endl;
+    #endif
+
+    cout << "\norder conversion (ROW_MAJOR -> COLUMN_MAJOR)\n";
+    orderConversion<2>({{4096, 4096}});
+    orderConversion<3>({{256, 256, 256}});
+    orderConversion<4>({{64, 64, 64, 64}});
+    orderConversion<3>({{1000, 1000, 17}});
+
+    cout << "\nelement-wise kernels (bandwidth from/to L1/L2)\n";
+    elementwiseKernels<float>(4000);
+    elementwiseKernels<double>(2000);
+
+    cout << "\naxis reductions\n";
+    axisReductions(4096, 4096);
+    axisReductions(64, 1 << 18);
+    axisReductions(1 << 18, 64);
+
+    cout << "\nbroadcasting\n";
+    broadcastRow(4096, 4096);
+    broadcastRow(1 << 18, 16);
+
+    cout << "\nfile I/O\n";
+    fileIO(2048);
+    hyperslabStreaming(256, 512, 512);
+
+    cout << "\nelement access\n";
+    checkedAccess(64);
+
+    cout << "\nunravel index\n";
+    unravelIndex(100);
+
+    cout << "\nparallel reductions\n";
+    parallelReductions(1 << 18, 64);
+    parallelReductions(16, 1 << 20);
+
+    cout << "\nindexed loops\n";
+    forEachIndexed(256);
+
+    cout << "\ndone" << endl;
+}
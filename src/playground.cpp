@@ -126,6 +126,12 @@ int main()
                            return a + b;
                        });
         printarr(cc);
+
+        // same thing, using an expression (evaluated in a single loop, without temporaries)
+        const ha_type dd = aa + bb;
+        printarr(dd);
+        const ha_type ee = 2.0 * (aa - bb) / cc + hyper_array::sqrt(aa);
+        printarr(ee);
     }
 
     // in containers
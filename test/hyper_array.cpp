@@ -1,3 +1,19 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+
 #include "catch/catch.hpp"
 
 #include "../include/hyper_array/hyper_array.hpp"
@@ -22,3 +38,1613 @@ TEST_CASE("overhead", "[overhead]")
     REQUIRE(sizeof(hyper_array::array<value_type, 9>) == overhead(9));
 
 }
+
+namespace
+{
+
+/// counts the elements that are currently allocated through it
+template <typename T>
+struct counting_allocator
+{
+    using value_type = T;
+
+    std::ptrdiff_t* live;
+
+    explicit counting_allocator(std::ptrdiff_t* counter) : live(counter) {}
+    template <typename U>
+    counting_allocator(const counting_allocator<U>& other) : live(other.live) {}
+
+    T* allocate(std::size_t n)
+    {
+        *live += static_cast<std::ptrdiff_t>(n);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        *live -= static_cast<std::ptrdiff_t>(n);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    template <typename U> bool operator==(const counting_allocator<U>& o) const { return live == o.live; }
+    template <typename U> bool operator!=(const counting_allocator<U>& o) const { return live != o.live; }
+};
+
+/// the directory where the tests create their files
+std::string tempDirectory()
+{
+    for (const char* variable : {"TMPDIR", "TMP", "TEMP"})
+    {
+        const char* directory = std::getenv(variable);
+        if ((directory != nullptr) && (*directory != '\0'))
+        {
+            return directory;
+        }
+    }
+    return "/tmp";
+}
+
+/// a file of the temporary directory, which is removed at the end of the scope (i.e. even if a test fails)
+struct temp_file
+{
+    const std::string path;
+
+    explicit temp_file(const std::string& name) : path(tempDirectory() + "/" + name) {}
+    temp_file(const temp_file&) = delete;
+    temp_file& operator=(const temp_file&) = delete;
+    ~temp_file() { std::remove(path.c_str()); }
+};
+
+}
+
+TEST_CASE("allocator", "[allocator]")
+{
+    using alloc_type = counting_allocator<int>;
+    using ha_type    = hyper_array::array<int, 2, hyper_array::array_order::ROW_MAJOR, alloc_type>;
+
+    std::ptrdiff_t live = 0;
+    const alloc_type alloc{&live};
+    {
+        ha_type aa{{{2, 3}}, nullptr, alloc};
+        REQUIRE(live == 6);
+        REQUIRE(aa.get_allocator() == alloc);
+        std::iota(aa.begin(), aa.end(), 0);
+
+        // copies are allocated using the same allocator
+        ha_type bb{aa};
+        REQUIRE(live == 12);
+        REQUIRE(std::equal(aa.begin(), aa.end(), bb.begin()));
+
+        // moves don't allocate anything
+        ha_type cc{std::move(bb)};
+        REQUIRE(live == 12);
+
+        // raw data is released through the allocator
+        alloc_type rawAlloc{alloc};
+        int* rawData = rawAlloc.allocate(4);
+        ha_type dd{{{2, 2}}, rawData, alloc};
+        REQUIRE(live == 16);
+        REQUIRE(dd.data() == rawData);
+
+        const ha_type ee{{{1, 3}}, {7, 8, 9}, 0, alloc};
+        REQUIRE(live == 19);
+        REQUIRE(ee(0, 2) == 9);
+
+        // the allocator isn't propagated on move assignment: equal allocators take the data over...
+        const int* const ccData = cc.data();
+        dd = std::move(cc);
+        REQUIRE(live == 15);
+        REQUIRE(dd.data() == ccData);
+
+        // ...other ones allocate their own copy, and release it
+        std::ptrdiff_t otherLive = 0;
+        {
+            ha_type ff{{{3, 3}}, nullptr, alloc_type{&otherLive}};
+            std::iota(ff.begin(), ff.end(), 0);
+            dd = std::move(ff);
+            REQUIRE(otherLive == 9);
+            REQUIRE(live == 18);
+            REQUIRE(dd.get_allocator() == alloc);
+            REQUIRE(dd(2, 2) == 8);
+        }
+        REQUIRE(otherLive == 0);
+    }
+    REQUIRE(live == 0);
+}
+
+TEST_CASE("alignment", "[allocator]")
+{
+    REQUIRE((hyper_array::array<double, 3>::alignment() == alignof(double)));
+
+    using alloc_type = hyper_array::aligned_allocator<double, hyper_array::avx512_alignment>;
+    using ha_type    = hyper_array::array<double, 3, hyper_array::array_order::ROW_MAJOR, alloc_type>;
+    REQUIRE(ha_type::alignment() == 64);
+
+    ha_type aa{3, 5, 7};
+    REQUIRE(aa.is_aligned());
+    REQUIRE(reinterpret_cast<std::uintptr_t>(aa.data()) % 64 == 0);
+    std::iota(aa.begin(), aa.end(), 0.0);
+
+    ha_type bb{aa};
+    REQUIRE(bb.is_aligned());
+    REQUIRE(std::equal(aa.begin(), aa.end(), bb.begin()));
+
+    ha_type cc{1, 1, 1};
+    cc = bb;
+    REQUIRE(cc.is_aligned());
+    cc = std::move(bb);
+    REQUIRE(cc.is_aligned());
+    REQUIRE(std::equal(aa.begin(), aa.end(), cc.begin()));
+}
+
+TEST_CASE("uninitialized", "[construction]")
+{
+    hyper_array::array<double, 3> aa{hyper_array::uninitialized, 2, 3, 4};
+    REQUIRE(aa.size() == 24);
+    REQUIRE((aa.coeffs() == std::array<std::size_t, 3>{{12, 4, 1}}));
+    std::iota(aa.begin(), aa.end(), 0.0);
+    REQUIRE(aa(1, 2, 3) == 23.0);
+
+    using alloc_type = counting_allocator<int>;
+    std::ptrdiff_t live = 0;
+    {
+        hyper_array::array<int, 2, hyper_array::array_order::COLUMN_MAJOR, alloc_type> bb{
+            hyper_array::uninitialized, {{5, 6}}, alloc_type{&live}};
+        REQUIRE(live == 30);
+        REQUIRE((bb.coeffs() == std::array<std::size_t, 2>{{1, 5}}));
+    }
+    REQUIRE(live == 0);
+}
+
+TEST_CASE("array_view", "[view]")
+{
+    std::vector<int> buffer(24);
+    std::iota(buffer.begin(), buffer.end(), 0);
+
+    SECTION("dense")
+    {
+        hyper_array::array_view<int, 3> view{buffer.data(), 2, 3, 4};
+        REQUIRE(view.size() == 24);
+        REQUIRE(view.is_contiguous());
+        REQUIRE(view(1, 2, 3) == 23);
+        REQUIRE(&view.at(1, 0, 2) == &buffer[14]);
+        REQUIRE(view[view.rawIndex(1, 1, 1)] == view(1, 1, 1));
+        REQUIRE(std::equal(view.begin(), view.end(), buffer.begin()));
+        REQUIRE(std::equal(view.rbegin(), view.rend(), buffer.rbegin()));
+
+        view(0, 0, 1) = -1;
+        REQUIRE(buffer[1] == -1);
+
+        const hyper_array::array_view<const int, 3, hyper_array::array_order::COLUMN_MAJOR> col{buffer.data(), {{2, 3, 4}}};
+        REQUIRE((col.coeffs() == std::array<std::ptrdiff_t, 3>{{1, 2, 6}}));
+        REQUIRE(col(1, 2, 3) == 23);
+        REQUIRE(std::equal(col.begin(), col.end(), buffer.begin()));
+    }
+
+    SECTION("strided")
+    {
+        // every other column of a 4x6 matrix
+        hyper_array::array_view<int, 2> view{buffer.data(), {{4, 3}}, {{6, 2}}};
+        REQUIRE(view.size() == 12);
+        REQUIRE_FALSE(view.is_contiguous());
+        REQUIRE(view(2, 1) == 14);
+
+        std::vector<int> expected;
+        for (int i = 0; i < 24; i += 2) { expected.push_back(i); }
+        REQUIRE(std::equal(view.begin(), view.end(), expected.begin()));
+        REQUIRE(std::equal(view.rbegin(), view.rend(), expected.rbegin()));
+        REQUIRE(std::distance(view.cbegin(), view.cend()) == 12);
+
+        hyper_array::array_view<const int, 2> constView = view;
+        REQUIRE(std::accumulate(constView.begin(), constView.end(), 0) == 132);
+    }
+
+    SECTION("padded and negative strides")
+    {
+        // 3x4 matrix stored in a 4x6 buffer
+        const auto strides = hyper_array::padded_strides<hyper_array::array_order::ROW_MAJOR>(std::array<std::size_t, 2>{{4, 6}});
+        REQUIRE((strides == std::array<std::ptrdiff_t, 2>{{6, 1}}));
+        hyper_array::array_view<int, 2> padded{buffer.data(), {{3, 4}}, strides};
+        REQUIRE(padded(2, 3) == 15);
+        REQUIRE_FALSE(padded.is_contiguous());
+
+        // the same matrix, upside down and mirrored
+        hyper_array::array_view<int, 2> flipped{&buffer[15], {{3, 4}}, {{-6, -1}}};
+        REQUIRE(flipped(0, 0) == 15);
+        REQUIRE(flipped(2, 3) == 0);
+        REQUIRE(flipped.rawIndex(1, 1) == -7);
+        REQUIRE(flipped[flipped.rawIndex(2, 1)] == flipped(2, 1));
+        REQUIRE(std::equal(flipped.begin(), flipped.end(), padded.rbegin()));
+        REQUIRE(std::equal(flipped.rbegin(), flipped.rend(), padded.begin()));
+
+        // transposed
+        hyper_array::array_view<const int, 2> transposed{buffer.data(), {{4, 3}}, {{1, 6}}};
+        REQUIRE(transposed(3, 2) == padded(2, 3));
+    }
+
+    SECTION("over a hyper array")
+    {
+        hyper_array::array<double, 2> arr{{{2, 2}}, {1, 2, 3, 4}};
+        hyper_array::array_view<double, 2> view = arr;
+        view(1, 0) = 30;
+        REQUIRE(arr.at(1, 0) == 30);
+
+        const auto& carr = arr;
+        hyper_array::array_view<const double, 2> cview = carr;
+        REQUIRE(cview.data() == arr.data());
+    }
+}
+
+TEST_CASE("static_array", "[static]")
+{
+    using row_type = hyper_array::static_array<int, hyper_array::extents<4, 4, 3>>;
+    using col_type = hyper_array::static_array<int, hyper_array::extents<4, 4, 3>, hyper_array::array_order::COLUMN_MAJOR>;
+
+    // no overhead: the elements are stored inline
+    REQUIRE(sizeof(row_type) == 48 * sizeof(int));
+    static_assert(row_type::size() == 48, "");
+    static_assert(row_type::coeff(0) == 12 && row_type::coeff(1) == 3 && row_type::coeff(2) == 1, "");
+    static_assert(col_type::coeff(0) == 1 && col_type::coeff(1) == 4 && col_type::coeff(2) == 16, "");
+    REQUIRE((row_type::lengths() == std::array<std::size_t, 3>{{4, 4, 3}}));
+    REQUIRE((col_type::coeffs() == std::array<std::size_t, 3>{{1, 4, 16}}));
+
+    row_type row{};
+    REQUIRE(std::all_of(row.begin(), row.end(), [](int x) { return x == 0; }));
+    std::iota(row.begin(), row.end(), 0);
+    REQUIRE(row(3, 2, 1) == 43);
+    REQUIRE(&row.at(1, 1, 1) == &row[16]);
+
+    col_type col;
+    for (std::size_t i = 0; i < 4; ++i)
+    for (std::size_t j = 0; j < 4; ++j)
+    for (std::size_t k = 0; k < 3; ++k)
+    {
+        col(i, j, k) = row(i, j, k);
+    }
+    REQUIRE(col[col.rawIndex(3, 2, 1)] == 43);
+    REQUIRE(col[1] == row(1, 0, 0));
+
+    const hyper_array::static_array<double, hyper_array::extents<2, 3>> init{{1, 2, 3, 4}, -1};
+    REQUIRE(init(0, 2) == 3);
+    REQUIRE(init(1, 2) == -1);
+}
+
+TEST_CASE("extents_array", "[static]")
+{
+    using hyper_array::dynamic_extent;
+
+    SECTION("extents")
+    {
+        using ext_type = hyper_array::extents<dynamic_extent, 4, dynamic_extent, 3>;
+        static_assert(ext_type::rank() == 4 && ext_type::rank_dynamic() == 2, "");
+        static_assert(ext_type::static_extent(1) == 4 && ext_type::static_extent(2) == dynamic_extent, "");
+        REQUIRE(sizeof(ext_type) == 2 * sizeof(std::size_t));
+
+        const ext_type ext{5, 6};
+        REQUIRE((ext.lengths() == std::array<std::size_t, 4>{{5, 4, 6, 3}}));
+    }
+
+    SECTION("row-major")
+    {
+        using ha_type = hyper_array::extents_array<int, hyper_array::extents<dynamic_extent, 3>>;
+        // only the dynamic length, the size and the data pointer are stored
+        REQUIRE(sizeof(ha_type) == 3 * sizeof(std::size_t));
+        REQUIRE(sizeof(ha_type) < sizeof(hyper_array::array<int, 2>));
+
+        ha_type aa{5};
+        REQUIRE(aa.size() == 15);
+        REQUIRE((aa.lengths() == std::array<std::size_t, 2>{{5, 3}}));
+        REQUIRE((aa.coeffs() == std::array<std::size_t, 2>{{3, 1}}));
+        std::iota(aa.begin(), aa.end(), 0);
+        REQUIRE(aa(4, 2) == 14);
+        REQUIRE(&aa.at(2, 1) == &aa[7]);
+
+        ha_type bb{aa};
+        REQUIRE(std::equal(aa.begin(), aa.end(), bb.begin()));
+        ha_type cc{1};
+        cc = std::move(bb);
+        REQUIRE(cc.length(0) == 5);
+        REQUIRE(cc(4, 2) == 14);
+
+        // the allocator isn't propagated on move assignment, cf. "allocator"
+        using counted_type = hyper_array::extents_array<int, hyper_array::extents<dynamic_extent, 3>,
+                                                        hyper_array::array_order::ROW_MAJOR, counting_allocator<int>>;
+        std::ptrdiff_t live = 0, otherLive = 0;
+        {
+            counted_type dd{counted_type::extents_type{1}, counting_allocator<int>{&live}};
+            counted_type ee{counted_type::extents_type{5}, counting_allocator<int>{&otherLive}};
+            std::copy(aa.begin(), aa.end(), ee.begin());
+            dd = std::move(ee);
+            REQUIRE(live == 15);
+            REQUIRE(otherLive == 15);
+            REQUIRE(dd.get_allocator() == counting_allocator<int>{&live});
+            REQUIRE(dd(4, 2) == 14);
+        }
+        REQUIRE(live == 0);
+        REQUIRE(otherLive == 0);
+    }
+
+    SECTION("matches hyper_array::array")
+    {
+        using hyper_array::array_order;
+        using ha_type = hyper_array::extents_array<int, hyper_array::extents<dynamic_extent, 4, dynamic_extent, 3>, array_order::COLUMN_MAJOR>;
+        REQUIRE(sizeof(ha_type) == 7 * sizeof(std::size_t));  // 2 lengths + 3 coeffs + size + pointer
+
+        ha_type aa{hyper_array::uninitialized, ha_type::extents_type{2, 5}};
+        hyper_array::array<int, 4, array_order::COLUMN_MAJOR> ref{2, 4, 5, 3};
+        REQUIRE(aa.coeffs() == ref.coeffs());
+        REQUIRE(aa.size() == ref.size());
+        REQUIRE(aa.rawIndex(1, 2, 3, 2) == ref.rawIndex(1, 2, 3, 2));
+    }
+}
+
+TEST_CASE("slice", "[view]")
+{
+    using hyper_array::range;
+    using hyper_array::all;
+
+    hyper_array::array<int, 3> arr{12, 4, 6};
+    std::iota(arr.begin(), arr.end(), 0);
+
+    SECTION("arr[2:10, :, 5]")
+    {
+        auto window = arr.slice(range(2, 10), all, 5);
+        static_assert(decltype(window)::dimensions() == 2, "");
+        REQUIRE((window.lengths() == std::array<std::size_t, 2>{{8, 4}}));
+        REQUIRE((window.coeffs() == std::array<std::ptrdiff_t, 2>{{24, 6}}));
+        for (std::size_t i = 0; i < 8; ++i)
+        for (std::size_t j = 0; j < 4; ++j)
+        {
+            REQUIRE(&window(i, j) == &arr(i + 2, j, 5));
+        }
+
+        // writes go to the parent
+        window(0, 0) = -1;
+        REQUIRE(arr(2, 0, 5) == -1);
+    }
+
+    SECTION("arr[::-3, 1, 1:6:2]")
+    {
+        const auto& carr = arr;
+        auto sub = carr.slice(range(11, -1, -3), 1, range(1, 6, 2));
+        static_assert(std::is_same<decltype(sub)::element_type, const int>::value, "");
+        REQUIRE((sub.lengths() == std::array<std::size_t, 2>{{4, 3}}));
+
+        std::vector<int> expected;
+        for (int i : {11, 8, 5, 2})
+        for (int k : {1, 3, 5})
+        {
+            expected.push_back(arr(i, 1, k));
+        }
+        REQUIRE(std::equal(sub.begin(), sub.end(), expected.begin()));
+    }
+
+    SECTION("slices of slices")
+    {
+        auto plane = arr.slice(3, all, all);
+        auto row   = plane.slice(2, range(0, 6));
+        REQUIRE(row.size() == 6);
+        REQUIRE(row.is_contiguous());
+        REQUIRE(row.data() == &arr(3, 2, 0));
+
+        auto empty = plane.slice(range(2, 2), all);
+        REQUIRE(empty.size() == 0);
+        REQUIRE(empty.begin() == empty.end());
+    }
+
+    SECTION("out of range")
+    {
+        // the tests are built with HYPER_ARRAY_CONFIG_Bounds_Check == HYPER_ARRAY_BOUNDS_CHECK_THROW
+        REQUIRE_THROWS_AS(arr.slice(12, all, all),               const std::out_of_range&);
+        REQUIRE_THROWS_AS(arr.slice(all, -1, all),               const std::out_of_range&);
+        REQUIRE_THROWS_AS(arr.slice(range(10, 13), all, all),    const std::out_of_range&);
+        REQUIRE_THROWS_AS(arr.slice(range(-1, 3), all, all),     const std::out_of_range&);
+        REQUIRE_THROWS_AS(arr.slice(all, all, range(5, -2, -2)), const std::out_of_range&);
+        REQUIRE_THROWS_AS(arr.slice(all, all, range(0, 6, 0)),   const std::invalid_argument&);
+        REQUIRE_THROWS_AS(arr.view().slice(all, range(0, 3), 6), const std::out_of_range&);
+
+        // the limits, and empty ranges, which select nothing
+        REQUIRE(arr.slice(range(11, -1, -1), 3, range(0, 6)).size() == 72);
+        REQUIRE(arr.slice(range(30, 20), all, all).size() == 0);
+    }
+}
+
+TEST_CASE("permute", "[view]")
+{
+    hyper_array::array<int, 3> chw{3, 40, 70};
+    std::iota(chw.begin(), chw.end(), 0);
+
+    auto hwc = chw.permute(1, 2, 0);
+    REQUIRE((hwc.lengths() == std::array<std::size_t, 3>{{40, 70, 3}}));
+    REQUIRE(hwc.data() == chw.data());
+    REQUIRE(&hwc(5, 6, 2) == &chw(2, 5, 6));
+
+    auto whc = chw.transpose();
+    REQUIRE(&whc(6, 5, 2) == &chw(2, 5, 6));
+    REQUIRE(&chw.view().swap_axes(0, 2)(6, 5, 2) == &chw(2, 5, 6));
+    REQUIRE_THROWS_AS(chw.view().swap_axes(0, 3), const std::out_of_range&);
+    REQUIRE_THROWS_AS(chw.view().swap_axes(7, 0), const std::out_of_range&);
+    REQUIRE_THROWS_AS(chw.permute(1, 3, 0),       const std::out_of_range&);
+
+    // materializing copies the elements into a dense array
+    const hyper_array::array<int, 3> dense = hyper_array::materialize(hwc);
+    REQUIRE(dense.lengths() == hwc.lengths());
+    REQUIRE(std::equal(hwc.begin(), hwc.end(), dense.begin()));
+
+    // copying between views with different layouts
+    hyper_array::array<int, 3, hyper_array::array_order::COLUMN_MAJOR> col{3, 40, 70};
+    hyper_array::copy(chw.view(), col.view());
+    bool same = true;
+    for (std::size_t c = 0; c < 3; ++c)
+    for (std::size_t h = 0; h < 40; ++h)
+    for (std::size_t w = 0; w < 70; ++w)
+    {
+        same = same && (col(c, h, w) == chw(c, h, w));
+    }
+    REQUIRE(same);
+
+    // 1D views and strided sources
+    auto everyOther = hyper_array::materialize(chw.slice(1, 7, hyper_array::range(69, -1, -2)));
+    REQUIRE(everyOther.size() == 35);
+    REQUIRE(everyOther[0] == chw(1, 7, 69));
+    REQUIRE(everyOther[34] == chw(1, 7, 1));
+}
+
+TEST_CASE("order conversion", "[construction]")
+{
+    using hyper_array::array_order;
+
+    hyper_array::array<double, 4, array_order::ROW_MAJOR> row{7, 33, 5, 70};
+    std::iota(row.begin(), row.end(), 0.0);
+
+    const hyper_array::array<double, 4, array_order::COLUMN_MAJOR> col{row};
+    REQUIRE(col.lengths() == row.lengths());
+
+    bool same = true;
+    for (std::size_t i = 0; i < 7; ++i)
+    for (std::size_t j = 0; j < 33; ++j)
+    for (std::size_t k = 0; k < 5; ++k)
+    for (std::size_t l = 0; l < 70; ++l)
+    {
+        same = same && (col(i, j, k, l) == row(i, j, k, l));
+    }
+    REQUIRE(same);
+
+    // and back
+    const hyper_array::array<double, 4, array_order::ROW_MAJOR> back{col};
+    REQUIRE(std::equal(row.begin(), row.end(), back.begin()));
+
+    // 1D and 2D
+    const hyper_array::array<int, 1, array_order::COLUMN_MAJOR> vec{hyper_array::array<int, 1>{{{3}}, {1, 2, 3}}};
+    REQUIRE(vec[2] == 3);
+    const hyper_array::array<int, 2, array_order::COLUMN_MAJOR> mat{hyper_array::array<int, 2>{{{2, 3}}, {11, 12, 13, 21, 22, 23}}};
+    REQUIRE((std::vector<int>(mat.begin(), mat.end()) == std::vector<int>{11, 21, 12, 22, 13, 23}));
+}
+
+TEST_CASE("expressions", "[arithmetic]")
+{
+    using hyper_array::array_order;
+
+    hyper_array::array<double, 3> a{2, 3, 4};
+    hyper_array::array<double, 3> b{2, 3, 4};
+    std::iota(a.begin(), a.end(), 1.0);
+    std::iota(b.rbegin(), b.rend(), 1.0);
+
+    SECTION("fused")
+    {
+        const hyper_array::array<double, 3> c = a + b * 2.0 - 1.0;
+        REQUIRE(c.lengths() == a.lengths());
+        for (std::size_t i = 0; i < c.size(); ++i)
+        {
+            REQUIRE(c[i] == a[i] + b[i] * 2.0 - 1.0);
+        }
+
+        const hyper_array::array<double, 3> d = -(a / b) + hyper_array::sqrt(a * a) + hyper_array::abs(-b);
+        REQUIRE(d[5] == Approx(-(a[5] / b[5]) + a[5] + b[5]));
+
+        // user-defined functions, and expressions with different value types
+        const hyper_array::array<int, 3> e = hyper_array::elementwise([](double x, double y) { return x < y ? x : y; }, a, b);
+        REQUIRE(e[0] == 1);
+        REQUIRE(e[23] == 1);
+        REQUIRE(e[11] == 12);
+    }
+
+    SECTION("assignment")
+    {
+        hyper_array::array<double, 3> c{1, 1, 1};
+        c = a * b;  // reallocates
+        REQUIRE(c.lengths() == a.lengths());
+        REQUIRE(c[7] == a[7] * b[7]);
+
+        c += a;
+        REQUIRE(c[7] == a[7] * b[7] + a[7]);
+        c -= 1.0;
+        c *= 2.0;
+        c /= b;
+        REQUIRE(c[7] == Approx((a[7] * b[7] + a[7] - 1.0) * 2.0 / b[7]));
+
+        // the destination can be one of the operands
+        c = c * 0.0 + a;
+        REQUIRE(std::equal(a.begin(), a.end(), c.begin()));
+
+        // ... even when it is reallocated
+        hyper_array::array<double, 2> m{4, 5};
+        std::iota(m.begin(), m.end(), 0.0);
+        m = m.slice(hyper_array::range(0, 2), hyper_array::all) + 1.0;
+        REQUIRE(m.lengths() == (::std::array<std::size_t, 2>{{2, 5}}));
+        REQUIRE(m(1, 4) == 10.0);
+    }
+
+    SECTION("strided")
+    {
+        // operands with different layouts are evaluated element (i, j, ...) by element (i, j, ...)
+        const hyper_array::array<double, 3, array_order::COLUMN_MAJOR> col{a};
+        const hyper_array::array<double, 2> t = a.slice(1, hyper_array::all, hyper_array::all).transpose() + col.slice(0, hyper_array::all, hyper_array::all).transpose();
+        REQUIRE(t.lengths() == (::std::array<std::size_t, 2>{{4, 3}}));
+        for (std::size_t i = 0; i < 4; ++i)
+        for (std::size_t j = 0; j < 3; ++j)
+        {
+            REQUIRE(t(i, j) == a(1, j, i) + a(0, j, i));
+        }
+
+        // evaluating into a view
+        hyper_array::array<double, 3> c{2, 3, 4};
+        hyper_array::evaluate(b + 1.0, c.transpose().transpose());
+        hyper_array::evaluate(a.slice(hyper_array::all, hyper_array::range(0, 3, 2), hyper_array::all) * 10.0,
+                              c.slice(hyper_array::all, hyper_array::range(0, 3, 2), hyper_array::all));
+        REQUIRE(c(1, 1, 3) == b(1, 1, 3) + 1.0);
+        REQUIRE(c(1, 2, 3) == a(1, 2, 3) * 10.0);
+        REQUIRE(c(0, 0, 1) == a(0, 0, 1) * 10.0);
+    }
+}
+
+TEST_CASE("simd", "[arithmetic]")
+{
+    using hyper_array::simd::instruction_set;
+    using hyper_array::simd::comparison;
+
+    // 37 elements: full vectors and a remainder, whatever the instruction set
+    hyper_array::array<double, 2> a{37, 1};
+    hyper_array::array<double, 2> b{37, 1};
+    hyper_array::array<double, 2> out{37, 1};
+    hyper_array::array<bool,   2> mask{37, 1};
+    for (std::size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = static_cast<double>(i) - 18.5;
+        b[i] = (i % 3 == 0) ? a[i] : static_cast<double>(i % 5) - 2.0;
+    }
+    b[3] = std::numeric_limits<double>::quiet_NaN();
+
+    std::vector<float> fa(a.begin(), a.end());
+    std::vector<float> fb(b.begin(), b.end());
+    std::vector<float> fout(fa.size());
+
+    const instruction_set detected = hyper_array::simd::detected_instruction_set();
+    for (int isa = 0; isa <= static_cast<int>(detected); ++isa)
+    {
+        REQUIRE(hyper_array::simd::set_instruction_set(static_cast<instruction_set>(isa)) == static_cast<instruction_set>(isa));
+        INFO(hyper_array::simd::instruction_set_name(hyper_array::simd::active_instruction_set()));
+
+        hyper_array::simd::add(a, b, out);
+        REQUIRE(out[36] == a[36] + b[36]);
+        REQUIRE(std::isnan(out[3]));
+        hyper_array::simd::sub(a, b, out);
+        REQUIRE(out[35] == a[35] - b[35]);
+        hyper_array::simd::mul(a, b, out);
+        REQUIRE(out[34] == a[34] * b[34]);
+        hyper_array::simd::div(a, b, out);
+        REQUIRE(out[33] == a[33] / b[33]);
+        hyper_array::simd::fma(a, b, a, out);
+        REQUIRE(out[32] == Approx(a[32] * b[32] + a[32]));
+        hyper_array::simd::abs(a, out);
+        REQUIRE(out[0] == 18.5);
+        REQUIRE(out[36] == 17.5);
+
+        // NaN's behave as in `(a < b) ? a : b`
+        hyper_array::simd::min(a, b, out);
+        REQUIRE(out[0] == -18.5);
+        REQUIRE(out[35] == b[35]);
+        REQUIRE(std::isnan(out[3]));
+        hyper_array::simd::max(a, b, out);
+        REQUIRE(out[35] == a[35]);
+        REQUIRE(std::isnan(out[3]));
+
+        const std::pair<comparison, bool (*)(double, double)> comparisons[] = {
+            {comparison::equal,         [](double x, double y) { return x <= y && y <= x;    }},
+            {comparison::not_equal,     [](double x, double y) { return !(x <= y && y <= x); }},
+            {comparison::less,          [](double x, double y) { return x <  y;              }},
+            {comparison::less_equal,    [](double x, double y) { return x <= y;              }},
+            {comparison::greater,       [](double x, double y) { return x >  y;              }},
+            {comparison::greater_equal, [](double x, double y) { return x >= y;              }},
+        };
+        for (const auto& c : comparisons)
+        {
+            hyper_array::simd::compare(c.first, a, b, mask);
+            bool same = true;
+            for (std::size_t i = 0; i < a.size(); ++i)
+            {
+                same = same && (mask[i] == c.second(a[i], b[i]));
+            }
+            REQUIRE(same);
+        }
+
+        // float
+        hyper_array::simd::mul(fa.data(), fb.data(), fout.data(), fout.size());
+        REQUIRE(fout[36] == fa[36] * fb[36]);
+        hyper_array::simd::abs(fa.data(), fout.data(), fout.size());
+        REQUIRE(fout[1] == 17.5f);
+
+        // expressions use the kernels
+        out = a - b;
+        REQUIRE(out[30] == a[30] - b[30]);
+    }
+
+    REQUIRE(hyper_array::simd::set_instruction_set(instruction_set::avx512) == detected);
+}
+
+TEST_CASE("reductions", "[arithmetic]")
+{
+    using hyper_array::array_order;
+
+    // reduces along `axis` using operator()
+    const auto naiveSum = [](const hyper_array::array<double, 3, array_order::COLUMN_MAJOR>& arr, std::size_t axis, std::size_t i, std::size_t j) {
+        double result = 0.0;
+        for (std::size_t k = 0; k < arr.length(axis); ++k)
+        {
+            result += (axis == 0) ? arr(k, i, j) : (axis == 1) ? arr(i, k, j) : arr(i, j, k);
+        }
+        return result;
+    };
+
+    hyper_array::array<double, 3> row{5, 6, 37};
+    std::iota(row.begin(), row.end(), 1.0);
+    const hyper_array::array<double, 3, array_order::COLUMN_MAJOR> col{row};
+
+    for (std::size_t axis = 0; axis < 3; ++axis)
+    {
+        const hyper_array::array<double, 2>                          rowSum = hyper_array::sum(row, axis);
+        const hyper_array::array<double, 2, array_order::COLUMN_MAJOR> colSum = hyper_array::sum(col, axis);
+        REQUIRE(rowSum.lengths() == colSum.lengths());
+
+        bool same = true;
+        for (std::size_t i = 0; i < rowSum.length(0); ++i)
+        for (std::size_t j = 0; j < rowSum.length(1); ++j)
+        {
+            same = same && (rowSum(i, j) == naiveSum(col, axis, i, j)) && (colSum(i, j) == naiveSum(col, axis, i, j));
+        }
+        REQUIRE(same);
+    }
+
+    REQUIRE(hyper_array::sum(row, 2).lengths() == (::std::array<std::size_t, 2>{{5, 6}}));
+    REQUIRE(hyper_array::min(row, 0)(2, 3)  == row(0, 2, 3));
+    REQUIRE(hyper_array::max(col, 2)(4, 5)  == row(4, 5, 36));
+    REQUIRE(hyper_array::mean(row, 1)(1, 1) == Approx((row(1, 0, 1) + row(1, 5, 1)) / 2));
+    REQUIRE(hyper_array::prod(row, 1)(0, 0) == Approx(1.0 * 38 * 75 * 112 * 149 * 186));
+
+    // integers, empty and long dimensions
+    hyper_array::array<int, 2> ints{3, 5000};
+    std::fill(ints.begin(), ints.end(), 2);
+    ints(1, 4999) = -7;
+    const hyper_array::array<int, 1> columns = hyper_array::min(ints, 0);
+    REQUIRE(columns.size() == 5000);
+    REQUIRE(columns[0] == 2);
+    REQUIRE(columns[4999] == -7);
+    REQUIRE(hyper_array::sum(ints, 1)[2] == 10000);
+    REQUIRE(hyper_array::mean(ints, 1)[1] == (2 * 4999 - 7) / 5000);
+    REQUIRE(hyper_array::sum(hyper_array::array<int, 2>{4, 0}, 1)[3] == 0);
+    REQUIRE(hyper_array::sum(hyper_array::array<int, 2>{0, 4}, 1).size() == 0);
+
+    // custom reduction
+    const hyper_array::array<int, 1> anyNegative = hyper_array::reduce(ints, 1, [](int a, int b) { return (a < 0 || b < 0) ? -1 : 0; }, 0);
+    REQUIRE((std::vector<int>(anyNegative.begin(), anyNegative.end()) == std::vector<int>{0, -1, 0}));
+}
+
+TEST_CASE("parallel reductions", "[arithmetic]")
+{
+    hyper_array::thread_pool pool4{4};
+    hyper_array::thread_pool pool3{3};
+    hyper_array::thread_pool pool1{1};
+    REQUIRE(pool4.size() == 4);
+    REQUIRE(pool1.size() == 1);
+
+    // every index is visited once, by a valid worker, and nested loops run serially
+    std::vector<std::atomic<int>> visits(1000);
+    std::atomic<bool> validWorkers{true};
+    pool4.run(visits.size(), [&](std::size_t i, std::size_t worker) {
+        validWorkers = validWorkers && (worker < pool4.size());
+        pool4.parallel_for(1, [&](std::size_t) { ++visits[i]; });
+    });
+    REQUIRE(validWorkers);
+    REQUIRE(std::all_of(visits.begin(), visits.end(), [](const std::atomic<int>& v) { return v == 1; }));
+
+    // full array
+    hyper_array::array<double, 2> arr{3, (1 << 18) + 77};
+    for (std::size_t i = 0; i < arr.size(); ++i)
+    {
+        arr[i] = std::sin(static_cast<double>(i)) * 1e3 + 0.1;
+    }
+    arr[12345] = -5000.0;
+    arr[arr.size() - 1] = 7000.0;
+
+    const double serial = hyper_array::sum(arr);
+    REQUIRE(serial == Approx(std::accumulate(arr.begin(), arr.end(), 0.0)));
+    REQUIRE(hyper_array::sum(hyper_array::par.on(pool4), arr) == Approx(serial));
+    REQUIRE(hyper_array::sum(hyper_array::par, arr) == Approx(serial));
+    REQUIRE(hyper_array::min(hyper_array::par.on(pool4), arr) == -5000.0);
+    REQUIRE(hyper_array::max(hyper_array::par.on(pool3), arr) == 7000.0);
+    REQUIRE(hyper_array::mean(hyper_array::par.on(pool3), arr) == Approx(serial / static_cast<double>(arr.size())));
+
+    const double deterministic = hyper_array::sum(hyper_array::par.on(pool1).deterministic(), arr);
+    REQUIRE(deterministic == Approx(serial));
+    for (int run = 0; run < 4; ++run)
+    {
+        REQUIRE(hyper_array::sum(hyper_array::par.on(pool3).deterministic(), arr) == deterministic);
+        REQUIRE(hyper_array::sum(hyper_array::par.on(pool4).deterministic(), arr) == deterministic);
+    }
+
+    // small arrays are reduced serially
+    hyper_array::array<int, 1> small{4};
+    std::iota(small.begin(), small.end(), 1);
+    REQUIRE(hyper_array::prod(hyper_array::par.on(pool4), small) == 24);
+
+    // along an axis: the same results as the serial version, whatever the number of threads
+    const auto sameAsSerial = [&](const hyper_array::array<double, 2>& a, std::size_t axis) {
+        const hyper_array::array<double, 1> expected = hyper_array::sum(a, axis);
+        for (hyper_array::thread_pool* pool : {&pool1, &pool3, &pool4})
+        {
+            const hyper_array::array<double, 1> actual = hyper_array::sum(hyper_array::par.on(*pool), a, axis);
+            if (actual.size() != expected.size())
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < actual.size(); ++i)
+            {
+                if (std::abs(actual[i] - expected[i]) > 1e-9 * (1 + std::abs(expected[i])))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    };
+    REQUIRE(sameAsSerial(arr, 0));  // many outputs
+    REQUIRE(sameAsSerial(arr, 1));  // few long rows
+
+    hyper_array::array<double, 2> tall{(1 << 17) + 5, 3};
+    std::copy(arr.begin(), arr.begin() + static_cast<std::ptrdiff_t>(tall.size()), tall.begin());
+    REQUIRE(sameAsSerial(tall, 0));  // few long columns
+    REQUIRE(sameAsSerial(tall, 1));
+
+    tall(100000, 1) = 9000.0;
+    REQUIRE(hyper_array::max(hyper_array::par.on(pool4), tall, 0)[1] == 9000.0);
+}
+
+TEST_CASE("parallel for_each", "[parallel]")
+{
+    hyper_array::thread_pool pool{4};
+
+    // uneven tasks are balanced by work stealing
+    std::vector<std::atomic<int>> visits(257);
+    pool.run(visits.size(), [&](std::size_t i, std::size_t) {
+        volatile double x = 0.0;
+        for (std::size_t n = 0; n < ((i < 8) ? 100000 : 10); ++n)
+        {
+            x = x + 1.0;
+        }
+        ++visits[i];
+    });
+    REQUIRE(std::all_of(visits.begin(), visits.end(), [](const std::atomic<int>& v) { return v == 1; }));
+
+    const auto encode = [](std::size_t i, std::size_t j, std::size_t k) {
+        return static_cast<double>(i * 1000000 + j * 1000 + k);
+    };
+
+    SECTION("row major")
+    {
+        hyper_array::array<double, 3, hyper_array::array_order::ROW_MAJOR> arr{7, 300, 50};
+        hyper_array::parallel_for_each(hyper_array::par.on(pool), arr, [&](double& x, std::size_t i, std::size_t j, std::size_t k) {
+            x = encode(i, j, k);
+        });
+        bool same = true;
+        for (std::size_t i = 0; i < 7; ++i)
+        for (std::size_t j = 0; j < 300; ++j)
+        for (std::size_t k = 0; k < 50; ++k)
+        {
+            same = same && (arr(i, j, k) == encode(i, j, k));
+        }
+        REQUIRE(same);
+    }
+
+    SECTION("column major, long rows")
+    {
+        hyper_array::array<double, 3, hyper_array::array_order::COLUMN_MAJOR> arr{10000, 3, 2};
+        hyper_array::parallel_for_each(hyper_array::par.on(pool), arr, [&](double& x, std::size_t i, std::size_t j, std::size_t k) {
+            x = encode(i, j, k);
+        });
+        bool same = true;
+        for (std::size_t i = 0; i < 10000; ++i)
+        for (std::size_t j = 0; j < 3; ++j)
+        for (std::size_t k = 0; k < 2; ++k)
+        {
+            same = same && (arr(i, j, k) == encode(i, j, k));
+        }
+        REQUIRE(same);
+    }
+
+    SECTION("strided view")
+    {
+        hyper_array::array<double, 3> arr{20, 30, 40};
+        std::fill(arr.begin(), arr.end(), -1.0);
+        const auto view = arr.slice(hyper_array::range(2, 18, 3), hyper_array::all, hyper_array::range(39, -1, -2));
+        std::atomic<std::size_t> count{0};
+        hyper_array::parallel_for_each(hyper_array::par.on(pool), view, [&](double& x, std::size_t i, std::size_t j, std::size_t k) {
+            x = encode(i, j, k);
+            ++count;
+        });
+        REQUIRE(count == view.size());
+        REQUIRE(arr(2, 0, 39)  == encode(0, 0, 0));
+        REQUIRE(arr(17, 29, 1) == encode(5, 29, 19));
+        REQUIRE(arr(17, 29, 0) == -1.0);
+        REQUIRE(arr(3, 0, 39)  == -1.0);
+    }
+
+    SECTION("default pool, const and empty arrays")
+    {
+        const hyper_array::array<int, 2> arr{3, 4};
+        std::atomic<int> count{0};
+        hyper_array::parallel_for_each(arr, [&](const int&, std::size_t i, std::size_t j) { count += static_cast<int>(i * 4 + j); });
+        REQUIRE(count == 66);
+
+        hyper_array::array<int, 2> empty{0, 4};
+        hyper_array::parallel_for_each(empty, [](int&, std::size_t, std::size_t) { FAIL(); });
+    }
+}
+
+TEST_CASE("nd cursor", "[view]")
+{
+    hyper_array::array<int, 3> arr{3, 4, 5};
+    std::iota(arr.begin(), arr.end(), 0);
+
+    SECTION("memory order")
+    {
+        int  expected = 0;
+        bool same     = true;
+        auto c        = arr.cursor();
+        for (; c.valid(); ++c, ++expected)
+        {
+            same = same && (*c == expected) && (c.get() == &arr(c.index(0), c.index(1), c.index(2)));
+        }
+        REQUIRE(same);
+        REQUIRE(expected == 60);
+
+        hyper_array::array<int, 2, hyper_array::array_order::COLUMN_MAJOR> col{3, 2};
+        std::vector<std::array<std::size_t, 2>> indices;
+        for (auto cc = col.cursor(); cc.valid(); ++cc)
+        {
+            indices.push_back(cc.indices());
+        }
+        REQUIRE((indices == std::vector<std::array<std::size_t, 2>>{{{0, 0}}, {{1, 0}}, {{2, 0}}, {{0, 1}}, {{1, 1}}, {{2, 1}}}));
+    }
+
+    SECTION("strided view")
+    {
+        const auto view = arr.slice(hyper_array::range(2, -1, -2), 1, hyper_array::range(1, 5, 3));
+        std::vector<int> values;
+        bool same = true;
+        for (auto c = view.cursor(); c.valid(); ++c)
+        {
+            values.push_back(*c);
+            same = same && (&*c == &view(c.index(0), c.index(1)));
+        }
+        REQUIRE(same);
+        REQUIRE((values == std::vector<int>{46, 49, 6, 9}));
+    }
+
+    SECTION("moving along a dimension")
+    {
+        const hyper_array::array<int, 3>& carr = arr;
+        auto c = carr.cursor();
+        c.next(2).next(2).next(0);
+        REQUIRE(*c == arr(1, 0, 2));
+        c.move(1, 3).prev(2);
+        REQUIRE(*c == arr(1, 3, 1));
+        REQUIRE((c.indices() == std::array<std::size_t, 3>{{1, 3, 1}}));
+
+        c.seek({{2, 3, 4}});
+        REQUIRE(*c == 59);
+        REQUIRE(c.valid());
+        ++c;
+        REQUIRE(!c.valid());
+
+        c.seek({{0, 1, 4}});
+        ++c;
+        REQUIRE(*c == arr(0, 2, 0));
+    }
+}
+
+TEST_CASE("bounds checking", "[access]")
+{
+    // the tests are built with HYPER_ARRAY_CONFIG_Bounds_Check == HYPER_ARRAY_BOUNDS_CHECK_THROW
+    hyper_array::array<int, 3> arr{2, 3, 4};
+    const hyper_array::static_array<int, hyper_array::extents<2, 3>> fixed{};
+    std::vector<int> buffer(24);
+    const hyper_array::array_view<int, 3> view{buffer.data(), 2, 3, 4};
+
+    REQUIRE_NOTHROW(arr.at(1, 2, 3));
+    REQUIRE_NOTHROW(view.at(0, 0, 0));
+    REQUIRE_NOTHROW(fixed.at(1, 2));
+    REQUIRE(arr.rawIndex(1, 2, 3) == 23);
+
+    // (catch's REQUIRE_THROWS_AS catches by value)
+    REQUIRE_THROWS_AS(arr.at(2, 0, 0),       const std::out_of_range&);
+    REQUIRE_THROWS_AS(arr.at(0, 0, -1),      const std::out_of_range&);
+    REQUIRE_THROWS_AS(arr.rawIndex(0, 3, 0), const std::out_of_range&);
+    REQUIRE_THROWS_AS(view.at(0, 3, 0),      const std::out_of_range&);
+    REQUIRE_THROWS_AS(fixed.at(2, 0),        const std::out_of_range&);
+    REQUIRE_THROWS_AS(fixed.rawIndex(0, 3),  const std::out_of_range&);
+
+    // every invalid index is reported
+    std::string message;
+    try
+    {
+        arr.at(5, 1, -2);
+    }
+    catch (const std::out_of_range& e)
+    {
+        message = e.what();
+    }
+    REQUIRE(message == "Index #0 [== 5] is out of the [0, 1] range. Index #2 [== -2] is out of the [0, 3] range. ");
+}
+
+TEST_CASE("32-bit indices", "[construction]")
+{
+    using array32 = hyper_array::array32<double, 3>;
+    static_assert(std::is_same<array32::size_type,  std::uint32_t>::value, "");
+    static_assert(std::is_same<array32::index_type, std::uint32_t>::value, "");
+    static_assert(std::is_same<hyper_array::array<double, 3>::size_type, std::size_t>::value, "");
+
+    // smaller "header"
+    REQUIRE(sizeof(array32) < sizeof(hyper_array::array<double, 3>));
+
+    array32 arr{4, 5, 6};
+    std::iota(arr.begin(), arr.end(), 0.0);
+    REQUIRE(arr.size() == 120);
+    REQUIRE((arr.lengths() == std::array<std::uint32_t, 3>{{4, 5, 6}}));
+    REQUIRE(arr(3, 1, 4) == 100.0);
+    REQUIRE(arr.at(3, 1, 4) == 100.0);
+    REQUIRE(arr.rawIndex(3, 1, 4) == 100);
+    REQUIRE_THROWS_AS(arr.at(4, 0, 0), const std::out_of_range&);
+    // indices are checked before being narrowed to index_type
+    REQUIRE_THROWS_AS(arr.at((1ull << 32) + 3, 1, 4), const std::out_of_range&);
+
+    // the rest of the library works with any index type
+    const hyper_array::array_view<const double, 3> view = arr;
+    REQUIRE(view(3, 1, 4) == 100.0);
+    REQUIRE(arr.slice(3, hyper_array::all, 4)(1) == 100.0);
+    REQUIRE(arr.transpose()(4, 1, 3) == 100.0);
+    REQUIRE(arr.cursor().get() == arr.data());
+
+    const array32 twice = arr + arr;
+    REQUIRE(twice(3, 1, 4) == 200.0);
+    REQUIRE(hyper_array::sum(arr) == 7140.0);
+    REQUIRE(hyper_array::sum(arr, 2)(3, 1) == 6 * 96.0 + 15);
+    const hyper_array::array<double, 3, hyper_array::array_order::COLUMN_MAJOR> col{arr};
+    REQUIRE(col(3, 1, 4) == 100.0);
+
+    // the number of elements must fit in size_type
+    using small_t = hyper_array::array<char, 2, hyper_array::array_order::ROW_MAJOR,
+                                       hyper_array::sized_allocator<std::allocator<char>, std::uint16_t>>;
+    REQUIRE_NOTHROW(small_t(255, 257));
+    REQUIRE_THROWS_AS(small_t(256, 256), const std::length_error&);
+    // ... and so must each length
+    REQUIRE_THROWS_AS(small_t(1 << 16, 1), const std::length_error&);
+    REQUIRE_THROWS_AS(small_t(hyper_array::uninitialized, 1, (1 << 16) + 3), const std::length_error&);
+    REQUIRE_THROWS_AS((hyper_array::array32<double, 2>{(1ull << 32) + 3, 5}), const std::length_error&);
+    REQUIRE_THROWS_AS((hyper_array::array<char, 3>{1u << 30, 1u << 30, 1u << 30}), const std::length_error&);
+}
+
+TEST_CASE("unravel index", "[access]")
+{
+    // division by invariant integers
+    std::vector<std::uint64_t> divisors{1, 2, 3, 5, 6, 7, 10, 64, 100, 641, 1000, 6700417, (1ull << 32) - 1, 1ull << 32,
+                                        (1ull << 32) + 1, (1ull << 63) - 25, 1ull << 63, (1ull << 63) + 1, ~0ull - 1, ~0ull};
+    std::vector<std::uint64_t> dividends{0, 1, 2, 3, 99, 100, 101, 12345678, (1ull << 32) - 1, 1ull << 32,
+                                         (1ull << 63) - 1, 1ull << 63, ~0ull - 1, ~0ull};
+    std::uint64_t seed = 42;
+    for (int i = 0; i < 200; ++i)
+    {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        divisors.push_back((seed >> (i % 64)) | 1);
+        dividends.push_back(seed);
+    }
+    bool exact = true;
+    for (const std::uint64_t d : divisors)
+    {
+        const hyper_array::internal::fast_divider divider{d};
+        for (const std::uint64_t n : dividends)
+        {
+            exact = exact && (divider.divide(n) == n / d);
+        }
+    }
+    REQUIRE(exact);
+
+    // offsets to multi-indices
+    hyper_array::array<int, 3> row{7, 1, 13};
+    hyper_array::array<int, 3, hyper_array::array_order::COLUMN_MAJOR> col{7, 1, 13};
+    std::iota(row.begin(), row.end(), 0);
+    std::iota(col.begin(), col.end(), 0);
+    const hyper_array::index_unraveler<3> rowUnraveler{row.lengths()};
+    const hyper_array::index_unraveler<3, hyper_array::array_order::COLUMN_MAJOR> colUnraveler{col.lengths()};
+    bool same = true;
+    for (std::size_t offset = 0; offset < row.size(); ++offset)
+    {
+        const std::array<std::size_t, 3> r = row.multiIndex(offset);
+        const std::array<std::size_t, 3> c = col.multiIndex(offset);
+        same = same && (row(r[0], r[1], r[2]) == static_cast<int>(offset)) && (rowUnraveler(offset) == r)
+                    && (col(c[0], c[1], c[2]) == static_cast<int>(offset)) && (colUnraveler(offset) == c);
+    }
+    REQUIRE(same);
+
+    row(4, 0, 9) = 1000;
+    const std::size_t argmax = static_cast<std::size_t>(std::max_element(row.begin(), row.end()) - row.begin());
+    REQUIRE((row.multiIndex(argmax) == std::array<std::size_t, 3>{{4, 0, 9}}));
+
+    // batched, with lengths that don't fit in 32 bits
+    const hyper_array::index_unraveler<2> wide{std::array<std::size_t, 2>{{3, 5000000000}}};
+    const std::vector<std::size_t> offsets{0, 4999999999, 5000000000, 14999999999};
+    std::vector<std::array<std::size_t, 2>> indices(offsets.size());
+    wide(offsets.begin(), offsets.end(), indices.begin());
+    REQUIRE((indices == std::vector<std::array<std::size_t, 2>>{{{0, 0}}, {{0, 4999999999}}, {{1, 0}}, {{2, 4999999999}}}));
+}
+
+TEST_CASE("broadcasting", "[arithmetic]")
+{
+    using hyper_array::array_order;
+
+    hyper_array::array<double, 2> a{3, 4};
+    hyper_array::array<double, 1> row{4};
+    hyper_array::array<double, 2> col{3, 1};
+    std::iota(a.begin(), a.end(), 0.0);
+    std::iota(row.begin(), row.end(), 100.0);
+    std::iota(col.begin(), col.end(), 10.0);
+
+    SECTION("views")
+    {
+        const auto rows = row.broadcast_to(3, 4);
+        REQUIRE(rows.lengths() == a.lengths());
+        REQUIRE(rows.coeffs() == (std::array<std::ptrdiff_t, 2>{{0, 1}}));
+        REQUIRE(rows(2, 3) == row(3));
+        REQUIRE(std::accumulate(rows.begin(), rows.end(), 0.0) == 3 * (100.0 + 101.0 + 102.0 + 103.0));
+
+        const auto cols = col.view().broadcast_to(std::array<std::size_t, 3>{{2, 3, 4}});
+        REQUIRE(cols.coeffs() == (std::array<std::ptrdiff_t, 3>{{0, 1, 0}}));
+        REQUIRE(cols(1, 2, 3) == col(2, 0));
+        REQUIRE(!cols.is_contiguous());
+    }
+
+    SECTION("expressions")
+    {
+        // {3, 4} with {4}, {3, 1} and {3, 1} with {4}
+        const hyper_array::array<double, 2> b = a - row;
+        const hyper_array::array<double, 2> c = a * col + 1.0;
+        const hyper_array::array<double, 2> d = col + row;
+        REQUIRE(b.lengths() == a.lengths());
+        REQUIRE(c.lengths() == a.lengths());
+        REQUIRE(d.lengths() == a.lengths());
+        for (std::size_t i = 0; i < 3; ++i)
+        for (std::size_t j = 0; j < 4; ++j)
+        {
+            REQUIRE(b(i, j) == a(i, j) - row(j));
+            REQUIRE(c(i, j) == a(i, j) * col(i, 0) + 1.0);
+            REQUIRE(d(i, j) == col(i, 0) + row(j));
+        }
+
+        // compound assignments, e.g. centering the columns
+        hyper_array::array<double, 2> e{a};
+        e -= hyper_array::mean(a, 0);
+        REQUIRE(hyper_array::sum(e) == Approx(0.0));
+        REQUIRE(e(2, 1) == a(2, 1) - (1.0 + 5.0 + 9.0) / 3);
+
+        // other layouts, and evaluation into a view
+        const hyper_array::array<double, 2, array_order::COLUMN_MAJOR> f{a};
+        const hyper_array::array<double, 1, array_order::COLUMN_MAJOR> g{row};
+        hyper_array::array<double, 2> h{4, 3};
+        hyper_array::evaluate(f + g, h.transpose());
+        REQUIRE(h(3, 2) == a(2, 3) + row(3));
+        REQUIRE(h(0, 1) == a(1, 0) + row(0));
+
+        // the destination is broadcast, then reallocated
+        hyper_array::array<double, 2> acc{1, 4};
+        std::iota(acc.begin(), acc.end(), 1.0);
+        acc = acc + a;
+        REQUIRE(acc.lengths() == a.lengths());
+        REQUIRE(acc(2, 3) == 4.0 + a(2, 3));
+        REQUIRE(acc(1, 0) == 1.0 + a(1, 0));
+
+        // but compound assignments and views can't be broadcast
+        REQUIRE_THROWS_AS(col += a, const std::invalid_argument&);
+        REQUIRE(col(2, 0) == 12.0);
+        REQUIRE_THROWS_AS(hyper_array::evaluate(a + row, col.view()), const std::invalid_argument&);
+        REQUIRE_THROWS_AS((a + hyper_array::array<double, 1>{3}), const std::invalid_argument&);
+    }
+}
+
+TEST_CASE("save and load", "[io]")
+{
+    using hyper_array::array_order;
+    const temp_file    tempFile{"hyper_array_test_saved.ha"};
+    const std::string& path = tempFile.path;
+
+    hyper_array::array<double, 3> a{3, 4, 5};
+    std::iota(a.begin(), a.end(), 0.5);
+
+    hyper_array::save(path, a);
+    const hyper_array::array<double, 3> b = hyper_array::load<double, 3>(path);
+    REQUIRE(b.lengths() == a.lengths());
+    REQUIRE(std::equal(a.begin(), a.end(), b.begin()));
+
+    // files stored in the other order are converted
+    const auto col = hyper_array::load<double, 3, array_order::COLUMN_MAJOR>(path);
+    REQUIRE(col(2, 1, 4) == a(2, 1, 4));
+
+    // views: transposed (i.e. dense in the other order) and strided
+    hyper_array::save(path, a.transpose());
+    const auto t = hyper_array::load<double, 3>(path);
+    REQUIRE(t.lengths() == (std::array<std::size_t, 3>{{5, 4, 3}}));
+    REQUIRE(t(4, 1, 2) == a(2, 1, 4));
+    hyper_array::save(path, a.slice(hyper_array::range(0, 3, 2), 1, hyper_array::all));
+    const auto s = hyper_array::load<double, 2>(path);
+    REQUIRE(s.lengths() == (std::array<std::size_t, 2>{{2, 5}}));
+    REQUIRE(s(1, 3) == a(2, 1, 3));
+
+    // empty arrays
+    hyper_array::save(path, hyper_array::array<int, 2>{0, 7});
+    REQUIRE((hyper_array::load<int, 2>(path).lengths() == std::array<std::size_t, 2>{{0, 7}}));
+
+    #if HYPER_ARRAY_MEMORY_MAPPING
+    // the same files can be mapped instead of being read
+    hyper_array::save(path, a);
+    const auto mapped = hyper_array::mapped_array<const double, 3>::open(path);
+    REQUIRE(std::equal(a.begin(), a.end(), mapped.data()));
+    #endif
+
+    // invalid files
+    REQUIRE_THROWS_AS((hyper_array::load<float, 3>(path)), const std::runtime_error&);
+    REQUIRE_THROWS_AS((hyper_array::load<double, 4>(path)), const std::runtime_error&);
+    std::remove(path.c_str());
+    REQUIRE_THROWS_AS((hyper_array::load<double, 3>(path)), const std::system_error&);
+    {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        std::fputs("not an array", file);
+        std::fclose(file);
+    }
+    REQUIRE_THROWS_AS((hyper_array::load<double, 1>(path)), const std::runtime_error&);
+
+    // lengths that don't match the file's size are rejected before allocating the array
+    hyper_array::save(path, a);
+    {
+        const std::uint64_t length = 1ull << 40;
+        std::FILE* file = std::fopen(path.c_str(), "r+b");
+        std::fseek(file, 24, SEEK_SET);
+        std::fwrite(&length, sizeof(length), 1, file);
+        std::fclose(file);
+    }
+    REQUIRE_THROWS_AS((hyper_array::load<double, 3>(path)), const std::runtime_error&);
+}
+
+TEST_CASE("npy files", "[io]")
+{
+    using hyper_array::array_order;
+    const temp_file    tempFile{"hyper_array_test.npy"};
+    const std::string& path = tempFile.path;
+
+    const auto readHeader = [&path]() -> std::string
+    {
+        std::FILE* file = std::fopen(path.c_str(), "rb");
+        char       header[128] = {};
+        const std::size_t size = std::fread(header, 1, sizeof(header), file);
+        std::fclose(file);
+        return std::string(header, size);
+    };
+
+    hyper_array::array<float, 3> a{2, 3, 4};
+    std::iota(a.begin(), a.end(), 0.5f);
+
+    hyper_array::save_npy(path, a);
+    const std::string header = readHeader();
+    REQUIRE(header.compare(0, 10, std::string("\x93NUMPY\x01\x00\x76\x00", 10)) == 0);
+    REQUIRE(header.substr(10, 62) == "{'descr': '<f4', 'fortran_order': False, 'shape': (2, 3, 4), }");
+    REQUIRE(header[127] == '\n');
+    const auto b = hyper_array::load_npy<float, 3>(path);
+    REQUIRE(b.lengths() == a.lengths());
+    REQUIRE(std::equal(a.begin(), a.end(), b.begin()));
+
+    // COLUMN_MAJOR arrays are stored in Fortran order
+    const hyper_array::array<float, 3, array_order::COLUMN_MAJOR> col{a};
+    hyper_array::save_npy(path, col);
+    REQUIRE(readHeader().find("'fortran_order': True") != std::string::npos);
+    REQUIRE((hyper_array::load_npy<float, 3>(path)(1, 2, 3) == a(1, 2, 3)));
+    REQUIRE((hyper_array::load_npy<float, 3, array_order::COLUMN_MAJOR>(path)(1, 0, 3) == a(1, 0, 3)));
+
+    // 1-D, and single-byte elements
+    hyper_array::array<bool, 1> flags{5};
+    flags[3] = true;
+    hyper_array::save_npy(path, flags.view());
+    REQUIRE(readHeader().substr(10, 57) == "{'descr': '|b1', 'fortran_order': False, 'shape': (5,), }");
+    REQUIRE((hyper_array::load_npy<bool, 1>(path)[3]));
+
+    // e.g. written by NumPy on a big-endian machine: `np.arange(6, dtype='>i4').reshape(2, 3, order='F')`
+    {
+        std::string dict = "{'descr': '>i4', 'fortran_order': True, 'shape': (2, 3), }";
+        dict.resize(128 - 10 - 1, ' ');
+        dict += '\n';
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        std::fwrite("\x93NUMPY\x01\x00\x76\x00", 1, 10, file);
+        std::fputs(dict.c_str(), file);
+        for (unsigned char i = 0; i < 6; ++i)
+        {
+            const unsigned char element[4] = {0, 0, 0, i};
+            std::fwrite(element, 1, 4, file);
+        }
+        std::fclose(file);
+    }
+    const auto big = hyper_array::load_npy<std::int32_t, 2>(path);
+    REQUIRE(big.lengths() == (std::array<std::size_t, 2>{{2, 3}}));
+    REQUIRE(big(0, 1) == 2);
+    REQUIRE(big(1, 2) == 5);
+    REQUIRE_THROWS_AS((hyper_array::load_npy<std::uint32_t, 2>(path)), const std::runtime_error&);
+    REQUIRE_THROWS_AS((hyper_array::load_npy<std::int32_t, 3>(path)), const std::runtime_error&);
+    REQUIRE_THROWS_AS((hyper_array::load_npy<std::int64_t, 2>(path)), const std::runtime_error&);
+
+    #if HYPER_ARRAY_MEMORY_MAPPING
+    REQUIRE_THROWS_AS((hyper_array::mapped_array<const std::int32_t, 2>::open_npy(path)), const std::runtime_error&);
+    hyper_array::save_npy(path, col);
+    const auto mapped = hyper_array::mapped_array<const float, 3>::open_npy(path);
+    REQUIRE(mapped(1, 2, 3) == a(1, 2, 3));
+    REQUIRE(mapped.data()[1] == a(1, 0, 0));
+    #endif
+
+    // hyper_array files aren't .npy files
+    hyper_array::save(path, a);
+    REQUIRE_THROWS_AS((hyper_array::load_npy<float, 3>(path)), const std::runtime_error&);
+}
+
+#if HYPER_ARRAY_MEMORY_MAPPING
+TEST_CASE("memory-mapped files", "[io]")
+{
+    using hyper_array::map_mode;
+    const temp_file    tempFile{"hyper_array_test_mapped.ha"};
+    const std::string& path = tempFile.path;
+
+    {
+        auto created = hyper_array::mapped_array<int, 3>::create(path, 2, 3, 4);
+        REQUIRE(created.lengths() == (std::array<std::size_t, 3>{{2, 3, 4}}));
+        REQUIRE(created.mode() == map_mode::read_write);
+        REQUIRE(std::all_of(created.begin(), created.end(), [](int x) { return x == 0; }));
+        std::iota(created.begin(), created.end(), 0);
+        created.flush();
+    }
+
+    {
+        // private copy: the file is left untouched
+        auto cow = hyper_array::mapped_array<int, 3>::open(path, map_mode::copy_on_write);
+        REQUIRE(cow(1, 2, 3) == 23);
+        cow(1, 2, 3) = -1;
+        REQUIRE(cow.at(1, 2, 3) == -1);
+    }
+
+    {
+        auto shared = hyper_array::mapped_array<int, 3>::open(path);
+        REQUIRE(shared(1, 2, 3) == 23);
+        shared(0, 0, 0) = 100;
+        shared.advise(hyper_array::map_advice::sequential);
+    }
+
+    {
+        auto readOnly = hyper_array::mapped_array<const int, 3>::open(path);
+        REQUIRE(readOnly.mode() == map_mode::read_only);
+        REQUIRE(readOnly(0, 0, 0) == 100);
+        REQUIRE(readOnly(1, 2, 3) == 23);
+
+        // the elements are read in place, e.g. by expressions
+        const hyper_array::array<int, 3> twice = readOnly.view() * 2;
+        REQUIRE(twice(1, 0, 1) == 26);
+
+        const auto moved = std::move(readOnly);
+        REQUIRE(moved(1, 2, 3) == 23);
+
+        // the number of dimensions and the element type are checked
+        REQUIRE_THROWS_AS((hyper_array::mapped_array<const int, 2>::open(path)), const std::runtime_error&);
+        REQUIRE_THROWS_AS((hyper_array::mapped_array<const float, 3>::open(path)), const std::runtime_error&);
+        REQUIRE_THROWS_AS((hyper_array::mapped_array<int, 3>::open(path, map_mode::read_only)), const std::invalid_argument&);
+    }
+
+    {
+        // arrays stored in COLUMN_MAJOR order are accessed through their strides
+        auto col = hyper_array::mapped_array<double, 2, hyper_array::array_order::COLUMN_MAJOR>::create(path, 3, 5);
+        col(2, 4) = 1.5;
+        col(1, 0) = 2.5;
+        REQUIRE(col.data()[14] == 1.5);
+        REQUIRE(col.data()[1] == 2.5);
+        col = hyper_array::mapped_array<double, 2, hyper_array::array_order::COLUMN_MAJOR>::open(path, map_mode::read_write);
+        const auto row = hyper_array::mapped_array<const double, 2>::open(path);
+        REQUIRE(row(2, 4) == 1.5);
+        REQUIRE(row.view().coeffs() == (std::array<std::ptrdiff_t, 2>{{1, 3}}));
+    }
+
+    REQUIRE_THROWS_AS((hyper_array::mapped_array<const int, 3>::open(tempDirectory() + "/hyper_array_test_missing.ha")), const std::system_error&);
+}
+#endif
+
+TEST_CASE("text formatting", "[io]")
+{
+    using hyper_array::array_order;
+
+    const auto format = [](const double x) -> std::string
+    {
+        std::ostringstream out;
+        hyper_array::write_text(out, hyper_array::array<double, 1>{{1}, {x}});
+        return out.str();
+    };
+
+    SECTION("numbers")
+    {
+        // shortest representations
+        REQUIRE(format(0.1) == "0.1\n");
+        REQUIRE(format(1.0 / 3) == "0.3333333333333333\n");
+        REQUIRE(format(-2.5) == "-2.5\n");
+        REQUIRE(format(100) == "100\n");
+        REQUIRE(format(1e20) == "1e+20\n");
+        REQUIRE(format(1.5e-7) == "1.5e-07\n");
+        REQUIRE(format(5e-324) == "5e-324\n");
+        REQUIRE(format(-std::numeric_limits<double>::infinity()) == "-inf\n");
+
+        // random bit patterns read back as the same values
+        std::mt19937_64 random{42};
+        hyper_array::array<double, 1> doubles{10000};
+        hyper_array::array<float,  1> floats{10000};
+        for (std::size_t i = 0; i < doubles.size(); ++i)
+        {
+            const std::uint64_t bits = random();
+            std::memcpy(&doubles[i], &bits, sizeof(double));
+            std::memcpy(&floats[i],  &bits, sizeof(float));
+            doubles[i] = std::isfinite(doubles[i]) ? doubles[i] : 0.0;
+            floats[i]  = std::isfinite(floats[i])  ? floats[i]  : 0.0f;
+        }
+        std::stringstream text;
+        hyper_array::write_text(text, doubles);
+        const auto doublesRead = hyper_array::read_text<double, 1>(text);
+        REQUIRE(std::memcmp(doublesRead.data(), doubles.data(), doubles.size() * sizeof(double)) == 0);
+        text.str("");
+        text.clear();
+        hyper_array::write_text(text, floats);
+        const auto floatsRead = hyper_array::read_text<float, 1>(text);
+        REQUIRE(std::memcmp(floatsRead.data(), floats.data(), floats.size() * sizeof(float)) == 0);
+
+        // integers, including the extreme values
+        const hyper_array::array<std::int64_t, 1> integers{{3}, {std::numeric_limits<std::int64_t>::min(), 0,
+                                                                 std::numeric_limits<std::int64_t>::max()}};
+        text.str("");
+        text.clear();
+        hyper_array::write_text(text, integers);
+        REQUIRE(text.str() == "-9223372036854775808 0 9223372036854775807\n");
+        const auto integersRead = hyper_array::read_text<std::int64_t, 1>(text);
+        REQUIRE(std::equal(integers.begin(), integers.end(), integersRead.begin()));
+
+        // long numbers, which don't fit in the stack buffer of the slow path
+        text.str("0." + std::string(200, '0') + "1 3.14159265358979323846" + std::string(150, '0') + "\n");
+        text.clear();
+        const auto longRead = hyper_array::read_text<double, 1>(text);
+        REQUIRE(longRead[0] == 1e-201);
+        REQUIRE(longRead[1] == 3.14159265358979323846);
+    }
+
+    SECTION("line breaks")
+    {
+        hyper_array::array<int, 3> a{2, 2, 3};
+        std::iota(a.begin(), a.end(), 0);
+
+        std::stringstream text;
+        hyper_array::write_text(text, a);
+        REQUIRE(text.str() == "0 1 2\n3 4 5\n\n6 7 8\n9 10 11\n\n\n");
+        const auto b = hyper_array::read_text<int, 3>(text);
+        REQUIRE(b.lengths() == a.lengths());
+        REQUIRE(std::equal(a.begin(), a.end(), b.begin()));
+
+        // views are written in their own order, rows run along the fastest dimension of the order
+        hyper_array::text_options csv;
+        csv.separator = ',';
+        text.str("");
+        text.clear();
+        hyper_array::write_text(text, a.view().transpose(), csv);
+        REQUIRE(text.str() == "0,6\n3,9\n\n1,7\n4,10\n\n2,8\n5,11\n\n\n");
+        const hyper_array::array<int, 3> c{hyper_array::read_text<int, 3, array_order::COLUMN_MAJOR>(text)};
+        REQUIRE(c.lengths() == a.lengths());
+        REQUIRE(std::equal(a.begin(), a.end(), c.begin()));
+
+        // everything on a single line
+        hyper_array::text_options singleLine;
+        singleLine.lineBreaks = false;
+        text.str("");
+        text.clear();
+        hyper_array::write_text(text, a, singleLine);
+        REQUIRE(text.str() == "0 1 2 3 4 5 6 7 8 9 10 11\n");
+    }
+
+    SECTION("invalid text")
+    {
+        std::istringstream ragged{"1 2 3\n4 5\n"};
+        REQUIRE_THROWS_AS((hyper_array::read_text<int, 2>(ragged)), const std::runtime_error&);
+        std::istringstream raggedBlocks{"1 2\n3 4\n\n5 6\n"};
+        REQUIRE_THROWS_AS((hyper_array::read_text<int, 3>(raggedBlocks)), const std::runtime_error&);
+        std::istringstream tooManyBreaks{"1 2\n\n3 4\n"};
+        REQUIRE_THROWS_AS((hyper_array::read_text<int, 2>(tooManyBreaks)), const std::runtime_error&);
+        std::istringstream notANumber{"1 2x 3\n"};
+        REQUIRE_THROWS_AS((hyper_array::read_text<double, 1>(notANumber)), const std::runtime_error&);
+        std::istringstream overflow{"1 256\n"};
+        REQUIRE_THROWS_AS((hyper_array::read_text<std::uint8_t, 1>(overflow)), const std::runtime_error&);
+    }
+
+    SECTION("stream errors")
+    {
+        // a full device: nothing can be written
+        struct full_buffer : std::streambuf
+        {
+            int_type overflow(int_type) override { return traits_type::eof(); }
+        };
+        full_buffer buffer;
+        std::ostream out{&buffer};
+        out.exceptions(std::ios::badbit);
+
+        // thrown by the last flush, and while writing (i.e. the buffer is also flushed during stack unwinding)
+        REQUIRE_THROWS_AS(hyper_array::write_text(out, hyper_array::array<int, 1>{10}), const std::ios_base::failure&);
+        out.clear();
+        REQUIRE_THROWS_AS(hyper_array::write_text(out, hyper_array::array<int, 1>{10000}), const std::ios_base::failure&);
+    }
+}
+
+TEST_CASE("hyperslab streaming", "[io]")
+{
+    using hyper_array::array_order;
+    using slab = hyper_array::hyperslab<3>;
+    const temp_file    tempFile{"hyper_array_test_slabs.ha"};
+    const temp_file    outputFile{"hyper_array_test_slabs_output.ha"};
+    const std::string& path   = tempFile.path;
+    const std::string& output = outputFile.path;
+
+    // {T, H, W}
+    hyper_array::array<int, 3> a{5, 6, 7};
+    std::iota(a.begin(), a.end(), 0);
+    hyper_array::save(path, a);
+
+    SECTION("tiles")
+    {
+        const auto tiles = hyper_array::tile_hyperslabs(a.lengths(), {{2, 6, 4}});
+        REQUIRE(tiles.size() == 6);
+        REQUIRE((tiles[1].offsets == std::array<std::size_t, 3>{{0, 0, 4}}));
+        REQUIRE((tiles[1].lengths == std::array<std::size_t, 3>{{2, 6, 3}}));
+        REQUIRE((tiles[5].offsets == std::array<std::size_t, 3>{{4, 0, 4}}));
+        REQUIRE((tiles[5].lengths == std::array<std::size_t, 3>{{1, 6, 3}}));
+        const auto columnTiles = hyper_array::tile_hyperslabs<array_order::COLUMN_MAJOR>(a.lengths(), {{2, 6, 4}});
+        REQUIRE((columnTiles[1].offsets == std::array<std::size_t, 3>{{2, 0, 0}}));
+
+        std::size_t total = 0;
+        for (const slab& tile : tiles)
+        {
+            total += tile.size();
+        }
+        REQUIRE(total == a.size());
+    }
+
+    SECTION("array_file")
+    {
+        const auto file = hyper_array::array_file<const int, 3>::open(path);
+        REQUIRE(file.lengths() == a.lengths());
+        REQUIRE(file.file_order() == array_order::ROW_MAJOR);
+
+        // whole frames, a box, and a box read into a transposed view
+        const auto frames = file.read({{2, 0, 0}, {{2, 6, 7}}});
+        REQUIRE(std::equal(frames.begin(), frames.end(), &a(2, 0, 0)));
+        const auto box = file.read({{1, 2, 3}, {{3, 4, 4}}});
+        REQUIRE(box(0, 0, 0) == a(1, 2, 3));
+        REQUIRE(box(2, 3, 3) == a(3, 5, 6));
+        hyper_array::array<int, 3> transposed{4, 4, 3};
+        file.read({{1, 2, 3}, {{3, 4, 4}}}, transposed.transpose());
+        REQUIRE(transposed(3, 1, 2) == a(3, 3, 6));
+
+        REQUIRE_THROWS_AS(file.read({{4, 0, 0}, {{2, 6, 7}}}), const std::out_of_range&);
+
+        // files in the other order, written with strided views
+        hyper_array::save(output, hyper_array::array<int, 3, array_order::COLUMN_MAJOR>{5, 6, 7});
+        auto col = hyper_array::array_file<int, 3>::open(output);
+        REQUIRE(col.file_order() == array_order::COLUMN_MAJOR);
+        col.write({{0, 0, 0}, a.lengths()}, a);
+        col.write({{1, 1, 1}, {{2, 2, 2}}}, a.slice(hyper_array::range(0, 4, 2), hyper_array::range(0, 4, 2), hyper_array::range(0, 4, 2)));
+        col.flush();
+        const auto written = hyper_array::load<int, 3>(output);
+        REQUIRE(written(4, 5, 6) == a(4, 5, 6));
+        REQUIRE(written(2, 2, 1) == a(2, 2, 0));
+        REQUIRE(written(2, 2, 2) == a(2, 2, 2));
+
+        // created files are zero
+        auto created = hyper_array::array_file<int, 3>::create(output, 3, 2, 2);
+        created.write({{2, 1, 0}, {{1, 1, 2}}}, hyper_array::array<int, 3>{{1, 1, 2}, {8, 9}});
+        created.flush();
+        const auto zeros = hyper_array::load<int, 3>(output);
+        REQUIRE(std::accumulate(zeros.begin(), zeros.end(), 0) == 17);
+        REQUIRE(zeros(2, 1, 1) == 9);
+    }
+
+    SECTION("reader and writer")
+    {
+        const auto input  = hyper_array::array_file<const int, 3>::open(path);
+        auto       result = hyper_array::array_file<int, 3>::create(output, input.lengths());
+        const auto slabs  = hyper_array::tile_hyperslabs(input.lengths(), {{2, 3, 7}});
+        {
+            hyper_array::hyperslab_reader<int, 3> reader{input, slabs, 3};
+            hyper_array::hyperslab_writer<int, 3> writer{result, slabs};
+            std::size_t count = 0;
+            while (reader.next() && writer.next())
+            {
+                REQUIRE(reader.index() == count++);
+                REQUIRE(reader.view().lengths() == reader.slab().lengths);
+                REQUIRE(reader.view()(0, 0, 0) == a(reader.slab().offsets[0], reader.slab().offsets[1], 0));
+                hyper_array::evaluate(reader.view() * 2, writer.view());
+            }
+            REQUIRE(count == slabs.size());
+            REQUIRE_FALSE(reader.next());
+            writer.flush();
+        }
+        const auto doubled = hyper_array::load<int, 3>(output);
+        REQUIRE(doubled(4, 5, 6) == 2 * a(4, 5, 6));
+        REQUIRE(doubled(3, 1, 2) == 2 * a(3, 1, 2));
+
+        // the current hyperslab isn't written when the processing is interrupted (i.e. without flush())
+        {
+            auto pair = hyper_array::array_file<int, 2>::create(output, 2, 4);
+            try
+            {
+                hyper_array::hyperslab_writer<int, 2> writer{pair, hyper_array::tile_hyperslabs(pair.lengths(), {{1, 4}}), 1};
+                REQUIRE(writer.next());
+                std::fill(writer.view().begin(), writer.view().end(), 7);
+                REQUIRE(writer.next());  // same buffer, still holding the 7s
+                throw std::runtime_error("processing failed");
+            }
+            catch (const std::runtime_error&)
+            {
+            }
+        }
+        const auto partial = hyper_array::load<int, 2>(output);
+        REQUIRE(partial(0, 3) == 7);
+        REQUIRE(partial(1, 0) == 0);
+        REQUIRE(partial(1, 3) == 0);
+
+        // at least one buffer is needed
+        REQUIRE_THROWS_AS((hyper_array::hyperslab_reader<int, 3>{input, slabs, 0}), const std::invalid_argument&);
+        REQUIRE_THROWS_AS((hyper_array::hyperslab_writer<int, 3>{result, slabs, 0}), const std::invalid_argument&);
+
+        // the reader can be destroyed before reading everything
+        {
+            hyper_array::hyperslab_reader<int, 3> reader{input, slabs, 1};
+            REQUIRE(reader.next());
+        }
+
+        // errors are reported by next()
+        {
+            std::FILE* file = std::fopen(path.c_str(), "r+b");
+            std::vector<unsigned char> bytes(64 + 100 * sizeof(int));
+            REQUIRE(std::fread(bytes.data(), 1, bytes.size(), file) == bytes.size());
+            std::fclose(file);
+            file = std::fopen(path.c_str(), "wb");
+            std::fwrite(bytes.data(), 1, bytes.size(), file);
+            std::fclose(file);
+        }
+        const auto truncated = hyper_array::array_file<const int, 3>::open(path);
+        hyper_array::hyperslab_reader<int, 3> reader{truncated, hyper_array::tile_hyperslabs(truncated.lengths(), {{1, 6, 7}})};
+        REQUIRE(reader.next());
+        REQUIRE(reader.view()(0, 1, 2) == a(0, 1, 2));
+        REQUIRE(reader.next());
+        REQUIRE_THROWS_AS(reader.next(), const std::runtime_error&);
+    }
+
+}